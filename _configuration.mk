@@ -0,0 +1,25 @@
+###
+ # THIS FILE IS AUTOMATICALLY GENERATED
+ # Do not edit this file. It will be overwritten when the configure script is run.
+###
+
+######
+# Build ID: 7cff6798715e740f
+# Executable: ./bin/champsim
+# Module Names: ('btbDbasic_btb', 'branchDbimodal', 'branchDgshare', 'branchDhashed_perceptron', 'branchDmeta_predictor', 'branchDmeta_predictor_budget', 'branchDmeta_predictor_hedge', 'branchDmeta_predictor_linucb', 'branchDmeta_predictor_thompson', 'branchDmeta_predictor_ucb', 'branchDperceptron', 'branchDtage_sc_l', 'prefetcherDip_stride', 'prefetcherDnext_line', 'prefetcherDno', 'prefetcherDspp_dev', 'prefetcherDva_ampm_lite', 'replacementDdrrip', 'replacementDlru', 'replacementDrandom', 'replacementDship', 'replacementDsrrip')
+######
+
+BIN_ROOT := bin
+$(BIN_ROOT)/champsim $(BIN_ROOT)/bpsim: build_id := \
+  7cff6798715e740f
+nonbase_module_objs += $(filter-out $(base_module_objs),$(call get_module_list, btb/basic_btb \
+  branch/bimodal branch/gshare branch/hashed_perceptron \
+  branch/meta_predictor branch/meta_predictor_budget branch/meta_predictor_hedge \
+  branch/meta_predictor_linucb branch/meta_predictor_thompson branch/meta_predictor_ucb \
+  branch/perceptron branch/tage_sc_l prefetcher/ip_stride \
+  prefetcher/next_line prefetcher/no prefetcher/spp_dev \
+  prefetcher/va_ampm_lite replacement/drrip replacement/lru \
+  replacement/random replacement/ship replacement/srrip \
+  ))
+executable_name += $(BIN_ROOT)/champsim
+bpsim_name += $(BIN_ROOT)/bpsim
@@ -1,12 +1,23 @@
 #include "bimodal.h"
 
-bool bimodal::predict_branch(champsim::address ip)
+template <int LOG_SCALE>
+bool basic_bimodal<LOG_SCALE>::predict_branch(champsim::address ip)
 {
-  auto value = bimodal_table[hash(ip)];
-  return value.value() > (value.maximum / 2);
+  last_counter = bimodal_table[hash(ip)];
+  return last_counter > (bimodal_table.maximum / 2);
 }
 
-void bimodal::last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type)
+template <int LOG_SCALE>
+void basic_bimodal<LOG_SCALE>::last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type)
 {
-  bimodal_table[hash(ip)] += taken ? 1 : -1;
+  bimodal_table.update(hash(ip), taken);
 }
+
+// every scale from branch_predictor::MIN_LOG_SCALE to MAX_LOG_SCALE
+template class basic_bimodal<-4>;
+template class basic_bimodal<-3>;
+template class basic_bimodal<-2>;
+template class basic_bimodal<-1>;
+template class basic_bimodal<0>;
+template class basic_bimodal<1>;
+template class basic_bimodal<2>;
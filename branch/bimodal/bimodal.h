@@ -1,21 +1,39 @@
 #ifndef BRANCH_BIMODAL_H
 #define BRANCH_BIMODAL_H
 
-#include <array>
-
 #include "address.h"
 #include "modules.h"
-#include "msl/fwcounter.h"
-
-class bimodal : public champsim::modules::branch_predictor
+#include "msl/packed_counter_array.h"
+
+/*
+ * A table of counters indexed by the address, with its size scaled by 2^LOG_SCALE from the default. The bimodal module is the
+ * default size.
+ */
+template <int LOG_SCALE>
+class basic_bimodal : public champsim::modules::branch_predictor
 {
+  // the largest prime that is not above n, so that the hash spreads addresses over the whole table
+  [[nodiscard]] static constexpr std::size_t largest_prime(std::size_t n)
+  {
+    auto is_prime = [](std::size_t k) {
+      for (std::size_t d = 2; d * d <= k; ++d)
+        if (k % d == 0)
+          return false;
+      return k >= 2;
+    };
+    while (!is_prime(n))
+      --n;
+    return n;
+  }
+
   [[nodiscard]] static constexpr auto hash(champsim::address ip) { return ip.to<unsigned long>() % PRIME; }
 
-  static constexpr std::size_t TABLE_SIZE = 16384;
-  static constexpr std::size_t PRIME = 16381;
+  static constexpr std::size_t TABLE_SIZE = scale_size(16384, LOG_SCALE);
+  static constexpr std::size_t PRIME = largest_prime(TABLE_SIZE);
   static constexpr std::size_t BITS = 2;
 
-  std::array<champsim::msl::fwcounter<BITS>, TABLE_SIZE> bimodal_table;
+  champsim::msl::packed_counter_array<BITS, TABLE_SIZE> bimodal_table;
+  unsigned last_counter = 0; // the value of the counter the last prediction was read from
 
 public:
   using branch_predictor::branch_predictor;
@@ -23,6 +41,23 @@ public:
   // void initialize_branch_predictor();
   bool predict_branch(champsim::address ip);
   void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+
+  // the strength of the counter the last prediction was read from, 0 when it is weak and 1 when it is saturated
+  [[nodiscard]] float prediction_confidence() const { return decltype(bimodal_table)::strength(last_counter); }
+
+  [[nodiscard]] static constexpr std::size_t storage_bits() { return TABLE_SIZE * BITS; }
+
+  template <typename Archive>
+  void snapshot_branch_predictor(Archive& archive)
+  {
+    archive(bimodal_table);
+  }
+};
+
+class bimodal : public basic_bimodal<0>
+{
+public:
+  using basic_bimodal::basic_bimodal;
 };
 
 #endif
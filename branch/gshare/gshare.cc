@@ -1,31 +1,67 @@
 #include "gshare.h"
 
-std::size_t gshare::gs_table_hash(champsim::address ip, std::bitset<GLOBAL_HISTORY_LENGTH> bh_vector)
+template <int LOG_SCALE>
+std::size_t basic_gshare<LOG_SCALE>::gs_table_hash(champsim::address ip, std::bitset<GLOBAL_HISTORY_LENGTH> bh_vector)
 {
   constexpr champsim::data::bits LOG2_HISTORY_TABLE_SIZE{champsim::lg2(GS_HISTORY_TABLE_SIZE)};
   constexpr champsim::data::bits LENGTH{GLOBAL_HISTORY_LENGTH};
 
   std::size_t hash = bh_vector.to_ullong();
-  hash ^= ip.slice<LOG2_HISTORY_TABLE_SIZE, champsim::data::bits{}>().to<std::size_t>();
-  hash ^= ip.slice<LOG2_HISTORY_TABLE_SIZE + LENGTH, LENGTH>().to<std::size_t>();
-  hash ^= ip.slice<LOG2_HISTORY_TABLE_SIZE + 2 * LENGTH, 2 * LENGTH>().to<std::size_t>();
+  hash ^= ip.slice<LOG2_HISTORY_TABLE_SIZE, champsim::data::bits{}>().template to<std::size_t>();
+  hash ^= ip.slice<LOG2_HISTORY_TABLE_SIZE + LENGTH, LENGTH>().template to<std::size_t>();
+  hash ^= ip.slice<LOG2_HISTORY_TABLE_SIZE + 2 * LENGTH, 2 * LENGTH>().template to<std::size_t>();
 
   return hash % GS_HISTORY_TABLE_SIZE;
 }
 
-bool gshare::predict_branch(champsim::address ip)
+template <int LOG_SCALE>
+bool basic_gshare<LOG_SCALE>::predict_branch(prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken,
+                                             uint8_t branch_type)
 {
-  auto gs_hash = gs_table_hash(ip, branch_history_vector);
-  auto value = gs_history_table[gs_hash];
-  return value.value() >= (value.maximum / 2);
+  prediction_state state{gs_table_hash(ip, std::bitset<GLOBAL_HISTORY_LENGTH>{branch_history.folded(0)})};
+  last_counter = gs_history_table[state.index];
+  const bool prediction = last_counter >= (gs_history_table.maximum / 2);
+
+  // branches enter the history as they are predicted, and it is repaired if they were mispredicted
+  if (branch_type != NOT_BRANCH) {
+    state.checkpoint = branch_history.speculate(prediction || always_taken);
+    state.in_history = true;
+  }
+
+  in_flight.push(id, state);
+  return prediction;
+}
+
+template <int LOG_SCALE>
+void basic_gshare<LOG_SCALE>::repair_branch_history(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken,
+                                                    uint8_t branch_type)
+{
+  auto* state = in_flight.find(id);
+  if (state != nullptr && state->in_history)
+    branch_history.repair(state->checkpoint, taken);
 }
 
-void gshare::last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type)
+template <int LOG_SCALE>
+void basic_gshare<LOG_SCALE>::last_branch_result(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken,
+                                                 uint8_t branch_type)
 {
-  auto gs_hash = gs_table_hash(ip, branch_history_vector);
-  gs_history_table[gs_hash] += taken ? 1 : -1;
+  auto* state = in_flight.find(id);
+  if (state == nullptr)
+    return; // the prediction was lost, so it cannot be trained, and the branch already entered the history when it was predicted
 
-  // update branch history vector
-  branch_history_vector <<= 1;
-  branch_history_vector[0] = taken;
+  if (state->in_history)
+    branch_history.repair(state->checkpoint, taken);
+  else
+    branch_history.push(taken);
+  gs_history_table.update(state->index, taken);
+  in_flight.erase(id);
 }
+
+// every scale from branch_predictor::MIN_LOG_SCALE to MAX_LOG_SCALE
+template struct basic_gshare<-4>;
+template struct basic_gshare<-3>;
+template struct basic_gshare<-2>;
+template struct basic_gshare<-1>;
+template struct basic_gshare<0>;
+template struct basic_gshare<1>;
+template struct basic_gshare<2>;
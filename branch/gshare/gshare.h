@@ -1,25 +1,72 @@
 #ifndef BRANCH_GSHARE_H
 #define BRANCH_GSHARE_H
 
-#include <array>
 #include <bitset>
 
+#include "instruction.h"
 #include "modules.h"
-#include "msl/fwcounter.h"
+#include "msl/bits.h"
+#include "msl/packed_counter_array.h"
+#include "msl/sequence_ring.h"
+#include "msl/speculative_history.h"
 
-struct gshare : champsim::modules::branch_predictor {
-  static constexpr std::size_t GLOBAL_HISTORY_LENGTH = 14;
+/*
+ * A table of counters indexed by the address and global history, with its size scaled by 2^LOG_SCALE from the default. The
+ * history is as long as the index. The gshare module is the default size.
+ */
+template <int LOG_SCALE>
+struct basic_gshare : champsim::modules::branch_predictor {
   static constexpr std::size_t COUNTER_BITS = 2;
-  static constexpr std::size_t GS_HISTORY_TABLE_SIZE = 16384;
+  static constexpr std::size_t GS_HISTORY_TABLE_SIZE = scale_size(16384, LOG_SCALE);
+  static constexpr std::size_t GLOBAL_HISTORY_LENGTH = champsim::msl::lg2(GS_HISTORY_TABLE_SIZE);
+  static constexpr std::size_t NUM_UPDATE_ENTRIES = MAX_PREDICTIONS_IN_FLIGHT;
+  static constexpr std::size_t HISTORY_RING_BITS = 2048;   // the history, and every branch that may be pushed into it before a repair
+  static_assert(HISTORY_RING_BITS >= GLOBAL_HISTORY_LENGTH + NUM_UPDATE_ENTRIES);
 
-  std::bitset<GLOBAL_HISTORY_LENGTH> branch_history_vector;
-  std::array<champsim::msl::fwcounter<COUNTER_BITS>, GS_HISTORY_TABLE_SIZE> gs_history_table;
+  // the history is updated as branches are predicted, and read as a single fold as wide as it is long
+  using history_type = champsim::msl::speculative_history<HISTORY_RING_BITS, 1>;
+
+  // what each unresolved prediction used
+  struct prediction_state {
+    std::size_t index = 0;                    // the counter the prediction was read from
+    history_type::checkpoint checkpoint = {}; // the history before this branch was pushed into it
+    bool in_history = false;                  // whether this was a branch, so that it was pushed
+  };
+
+  history_type branch_history{{{{GLOBAL_HISTORY_LENGTH, GLOBAL_HISTORY_LENGTH}}}};
+  champsim::msl::packed_counter_array<COUNTER_BITS, GS_HISTORY_TABLE_SIZE> gs_history_table;
+  champsim::msl::sequence_ring<prediction_state, NUM_UPDATE_ENTRIES> in_flight;
+  unsigned last_counter = 0; // the value of the counter the last prediction was read from
 
   using branch_predictor::branch_predictor;
 
   static std::size_t gs_table_hash(champsim::address ip, std::bitset<GLOBAL_HISTORY_LENGTH> bh_vector);
-  bool predict_branch(champsim::address ip);
-  void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+  bool predict_branch(prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type);
+  void last_branch_result(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+  void repair_branch_history(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+
+  // Without identifiers, each branch is resolved before the next is predicted
+  bool predict_branch(champsim::address ip) { return predict_branch(in_flight.last() + 1, ip, champsim::address{}, false, BRANCH_CONDITIONAL); }
+  void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type)
+  {
+    last_branch_result(in_flight.last(), ip, branch_target, taken, branch_type);
+  }
+
+  // the strength of the counter the last prediction was read from, 0 when it is weak and 1 when it is saturated
+  [[nodiscard]] float prediction_confidence() const { return decltype(gs_history_table)::strength(last_counter); }
+
+  [[nodiscard]] static constexpr std::size_t storage_bits() { return GS_HISTORY_TABLE_SIZE * COUNTER_BITS + GLOBAL_HISTORY_LENGTH; }
+
+  template <typename Archive>
+  void snapshot_branch_predictor(Archive& archive)
+  {
+    branch_history.snapshot(archive);
+    archive(gs_history_table);
+  }
+};
+
+struct gshare : basic_gshare<0> {
+  using basic_gshare::basic_gshare;
 };
 
 #endif
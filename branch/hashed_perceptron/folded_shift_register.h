@@ -9,26 +9,27 @@
 #include "util/bit_enum.h"
 
 /**
- * @brief A shift register that folds words before it returns its value.
+ * @brief A shift register that keeps its history folded into one word.
  *
  * This class maintains a history of bits that have been pushed into it.
- * When the user asks for its value, it folds the history in WORD_LEN chunks,
- * returning the XOR of the words.
+ * Its value is the history folded in WORD_LEN chunks, that is, the XOR of the
+ * words. The folded value is kept up to date as bits are pushed, in the manner
+ * of the circular shift registers of TAGE, so that both pushing and finding the
+ * value take constant time, whatever the length of the history.
  */
 template <champsim::data::bits WORD_LEN>
 class folded_shift_register
 {
-  /*
-   * This class uses two terms: "value" and "word". A value contains one or more packed words.
-   */
   using value_type = unsigned long long;
   static_assert(champsim::data::bits{std::numeric_limits<value_type>::digits} >= WORD_LEN);
-  constexpr static auto NUM_WORDS_PER_VALUE = champsim::data::bits{std::numeric_limits<value_type>::digits}
-                                              / WORD_LEN; // this many 12-bit words will be kept per int in the table in the global history
-  constexpr static auto VALUE_LEN = WORD_LEN * NUM_WORDS_PER_VALUE;
+  constexpr static auto WORD_BITS = champsim::to_underlying(WORD_LEN);
+  constexpr static auto RING_WORD_BITS = std::numeric_limits<value_type>::digits;
+
+  std::size_t history_length = 0; // The number of bits of history
+  std::size_t oldest = 0;         // The position in the ring of the oldest bit, which the next push replaces
+  value_type folded = 0;          // The history, folded
+  std::vector<value_type> ring;   // The history, as a ring of bits
 
-  value_type last_value_mask;    // The last word may not be the full width of the value
-  std::vector<value_type> words; // The history is represented as a series of values
 public:
   folded_shift_register();
   explicit folded_shift_register(champsim::data::bits length);
@@ -39,6 +40,17 @@ public:
    *  Insert this value into the shift register
    **/
   void push_back(bool ins);
+
+  /**
+   * Save or restore the history with a snapshot archive
+   */
+  template <typename Archive>
+  void snapshot(Archive& archive)
+  {
+    archive(ring);
+    archive(oldest);
+    archive(folded);
+  }
 };
 
 template <champsim::data::bits WORD_LEN>
@@ -48,52 +60,33 @@ folded_shift_register<WORD_LEN>::folded_shift_register() : folded_shift_register
 
 template <champsim::data::bits WORD_LEN>
 folded_shift_register<WORD_LEN>::folded_shift_register(champsim::data::bits length)
-    : last_value_mask(champsim::msl::bitmask(length % VALUE_LEN)), words((length / VALUE_LEN) + ((length % VALUE_LEN != champsim::data::bits{}) ? 1 : 0))
+    : history_length(champsim::to_underlying(length)), ring((champsim::to_underlying(length) + RING_WORD_BITS - 1) / RING_WORD_BITS)
 {
 }
 
 template <champsim::data::bits WORD_LEN>
 std::size_t folded_shift_register<WORD_LEN>::value() const
 {
-  // XOR all of the entries together
-  auto joined_words = std::accumulate(std::begin(words), std::end(words), value_type{}, std::bit_xor<>{});
-
-  // Unpack the words from the accumulated values
-  std::size_t result = joined_words;
-  if constexpr (NUM_WORDS_PER_VALUE > 1) {
-    for (std::size_t i = 0; i <= NUM_WORDS_PER_VALUE; ++i) {
-      joined_words >>= champsim::to_underlying(WORD_LEN);
-      result ^= joined_words;
-    }
-  }
-  return result & champsim::msl::bitmask(champsim::data::bits{WORD_LEN});
+  return folded;
 }
 
 template <champsim::data::bits WORD_LEN>
 void folded_shift_register<WORD_LEN>::push_back(bool ins)
 {
-  /**
-   * Find the MSB of the value. This MSB will be passed along to the next word in the array.
-   */
-  auto extract_msb = [](auto x) {
-    auto msb_loc = champsim::to_underlying(VALUE_LEN) - 1;
-    return (x & (value_type{1} << msb_loc)) >> msb_loc;
-  };
-
-  auto shift_and_apply_lsb = [](auto x, auto lsb) {
-    return ((x << 1) | lsb) & champsim::msl::bitmask(VALUE_LEN);
-  };
+  if (history_length == 0)
+    return;
 
-  // The MSBs to be passed to the next value.
-  // The vector is initialized with the new bit, so we get our shift for free.
-  std::vector<value_type> msbs = {ins ? value_type{0x1} : value_type{0x0}};
-  std::transform(std::cbegin(words), std::cend(words), std::back_inserter(msbs), extract_msb);
-  std::transform(std::cbegin(words), std::cend(words), std::begin(msbs), std::begin(words), shift_and_apply_lsb);
+  // Replace the oldest bit in the ring with the new one
+  auto& ring_word = ring[oldest / RING_WORD_BITS];
+  const auto ring_bit = oldest % RING_WORD_BITS;
+  const value_type outgoing = (ring_word >> ring_bit) & 1;
+  ring_word = (ring_word & ~(value_type{1} << ring_bit)) | (value_type{ins ? 1u : 0u} << ring_bit);
+  oldest = (oldest + 1 == history_length) ? 0 : oldest + 1;
 
-  // Don't apply the mask if the last value is full-width
-  if (last_value_mask != value_type{}) {
-    words.back() &= last_value_mask;
-  }
+  // Every bit moves up one place in its word, which rotates the folded value. The new bit enters at the bottom, and the outgoing
+  // bit, which would now be at the bit past the end of the history, is removed.
+  const auto rotated = ((folded << 1) | (folded >> (WORD_BITS - 1))) & champsim::msl::bitmask(WORD_LEN);
+  folded = rotated ^ (ins ? value_type{1} : value_type{0}) ^ (outgoing << (history_length % WORD_BITS));
 }
 
 #endif
@@ -0,0 +1,74 @@
+#ifndef BRANCH_HASHED_PERCEPTRON_GATHER_KERNEL_H
+#define BRANCH_HASHED_PERCEPTRON_GATHER_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define GATHER_KERNEL_X86 1
+#endif
+
+/*
+ * Kernels for the sum of one int8 weight from each of several tables, which are laid out one after another in a single array.
+ *
+ * The offsets are from the start of the array, and their number must be a multiple of GATHER_WIDTH. The AVX2 version gathers four
+ * bytes at each offset, so the array must extend GATHER_PADDING bytes past the last weight. It is used whenever the host supports
+ * it, whatever the compiler flags, and gives the same results as the scalar version.
+ */
+namespace gather_kernel
+{
+constexpr std::size_t GATHER_WIDTH = 8;
+constexpr std::size_t GATHER_PADDING = 3;
+
+namespace scalar
+{
+inline int sum(const int8_t* weights, const int32_t* offsets, std::size_t count)
+{
+  int result = 0;
+  for (std::size_t i = 0; i < count; ++i)
+    result += weights[offsets[i]];
+  return result;
+}
+} // namespace scalar
+
+#ifdef GATHER_KERNEL_X86
+namespace avx2
+{
+__attribute__((target("avx2"))) inline int sum(const int8_t* weights, const int32_t* offsets, std::size_t count)
+{
+  auto total = _mm256_setzero_si256();
+  for (std::size_t i = 0; i < count; i += GATHER_WIDTH) {
+    const auto gathered = _mm256_i32gather_epi32(reinterpret_cast<const int*>(weights), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets + i)), 1);
+
+    // Sign-extend the weight in the low byte of each gathered word
+    total = _mm256_add_epi32(total, _mm256_srai_epi32(_mm256_slli_epi32(gathered, 24), 24));
+  }
+
+  auto halves = _mm_add_epi32(_mm256_castsi256_si128(total), _mm256_extracti128_si256(total, 1));
+  halves = _mm_add_epi32(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(1, 0, 3, 2)));
+  halves = _mm_add_epi32(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(halves);
+}
+
+inline const bool supported = [] {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+}();
+} // namespace avx2
+#endif
+
+/**
+ * The sum of the weights at the given offsets.
+ */
+inline int sum(const int8_t* weights, const int32_t* offsets, std::size_t count)
+{
+#ifdef GATHER_KERNEL_X86
+  if (avx2::supported)
+    return avx2::sum(weights, offsets, count);
+#endif
+  return scalar::sum(weights, offsets, count);
+}
+} // namespace gather_kernel
+
+#endif
@@ -47,41 +47,77 @@ sources for you to plagiarize.
 
 #include "hashed_perceptron.h"
 
-#include <numeric>
+#include <cstdlib>
+#include <limits>
 
-bool hashed_perceptron::predict_branch(champsim::address pc)
+template <int LOG_SCALE>
+bool basic_hashed_perceptron<LOG_SCALE>::predict_branch(prediction_id id, champsim::address pc, champsim::address predicted_target, bool always_taken,
+                                                        uint8_t branch_type)
 {
-  auto get_index = [pc_slice = pc.slice_lower<TABLE_INDEX_BITS>().to<uint64_t>()](const auto& hist) {
-    return hist.value() ^ pc_slice; // seed in the PC to spread accesses around (like gshare) XOR in the last word
-  };
+  // seed in the PC to spread accesses around (like gshare) XOR in the last word, and offset each index into its own table
+  const auto pc_slice = pc.template slice_lower<TABLE_INDEX_BITS>().template to<uint64_t>();
   perceptron_result result;
-  std::transform(std::cbegin(ghist_words), std::cend(ghist_words), std::begin(result.indices), get_index);
+  for (std::size_t i = 0; i < NTABLES; ++i)
+    result.offsets[i] = static_cast<int32_t>(i * TABLE_SIZE + (ghist.folded(i) ^ pc_slice));
 
   // add the selected weights to the perceptron sum
-  result.yout = std::inner_product(std::begin(tables), std::end(tables), std::begin(result.indices), 0, std::plus<>{},
-                                   [](const auto& table, const auto& index) { return table.at(index).value(); });
-  last_result = result;
-  return result.yout >= THRESHOLD;
+  result.yout = gather_kernel::sum(std::data(tables), std::data(result.offsets), NTABLES);
+  const bool prediction = result.yout >= THRESHOLD;
+  last_yout = result.yout;
+
+  // branches enter the history as they are predicted, and it is repaired if they were mispredicted
+  if (branch_type != NOT_BRANCH) {
+    result.checkpoint = ghist.speculate(prediction || always_taken);
+    result.in_history = true;
+  }
+
+  results.push(id, result);
+  return prediction;
 }
 
-void hashed_perceptron::last_branch_result(champsim::address pc, champsim::address branch_target, bool taken, uint8_t branch_type)
+template <int LOG_SCALE>
+void basic_hashed_perceptron<LOG_SCALE>::repair_branch_history(prediction_id id, champsim::address pc, champsim::address branch_target, bool taken,
+                                                               uint8_t branch_type)
 {
-  for (auto& hist : ghist_words) {
-    hist.push_back(taken);
-  }
+  auto* result = results.find(id);
+  if (result != nullptr && result->in_history)
+    ghist.repair(result->checkpoint, taken);
+}
+
+template <int LOG_SCALE>
+void basic_hashed_perceptron<LOG_SCALE>::last_branch_result(prediction_id id, champsim::address pc, champsim::address branch_target, bool taken,
+                                                            uint8_t branch_type)
+{
+  auto* found = results.find(id);
+  if (found == nullptr)
+    return; // the result of the prediction was lost, so it cannot be trained, and the branch already entered the history when it was predicted
+
+  if (found->in_history)
+    ghist.repair(found->checkpoint, taken);
+  else
+    ghist.push(taken);
+  const auto prediction = *found;
+  results.erase(id);
 
   // perceptron learning rule: train if misprediction or weak correct prediction
-  bool prediction_correct = (taken == (last_result.yout >= THRESHOLD));
-  bool prediction_weak = (std::abs(last_result.yout) < theta);
+  bool prediction_correct = (taken == (prediction.yout >= THRESHOLD));
+  bool prediction_weak = (std::abs(prediction.yout) < theta);
   if (!prediction_correct || prediction_weak) {
-    for (std::size_t i = 0; i < std::size(tables); i++)
-      tables[i][last_result.indices[i]] += taken ? 1 : -1; // update weights
+    for (auto offset : prediction.offsets) {
+      // update weights, with saturating arithmetic
+      auto& weight = tables[static_cast<std::size_t>(offset)];
+      if (taken && weight < std::numeric_limits<int8_t>::max())
+        ++weight;
+      else if (!taken && weight > std::numeric_limits<int8_t>::min())
+        --weight;
+    }
     adjust_threshold(prediction_correct);
   }
 }
 
 // dynamic threshold setting from Seznec's O-GEHL paper
-void hashed_perceptron::adjust_threshold(bool correct)
+template <int LOG_SCALE>
+void basic_hashed_perceptron<LOG_SCALE>::adjust_threshold(bool correct)
 {
   constexpr int SPEED = 18; // speed for dynamic threshold setting
   if (!correct) {
@@ -100,3 +136,12 @@ void hashed_perceptron::adjust_threshold(bool correct)
     }
   }
 }
+
+// every scale from branch_predictor::MIN_LOG_SCALE to MAX_LOG_SCALE
+template class basic_hashed_perceptron<-4>;
+template class basic_hashed_perceptron<-3>;
+template class basic_hashed_perceptron<-2>;
+template class basic_hashed_perceptron<-1>;
+template class basic_hashed_perceptron<0>;
+template class basic_hashed_perceptron<1>;
+template class basic_hashed_perceptron<2>;
@@ -1,23 +1,32 @@
 #ifndef BRANCH_HASHED_PERCEPTRON_H
 #define BRANCH_HASHED_PERCEPTRON_H
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <cstdlib>
 #include <tuple>
 #include <vector>
 
-#include "folded_shift_register.h"
+#include "gather_kernel.h"
+#include "instruction.h"
 #include "modules.h"
 #include "msl/bits.h"
-#include "msl/fwcounter.h"
+#include "msl/sequence_ring.h"
+#include "msl/speculative_history.h"
 
-class hashed_perceptron : public champsim::modules::branch_predictor
+/*
+ * The hashed perceptron, with the size of each table scaled by 2^LOG_SCALE from the default. The hashed_perceptron module is the
+ * default size.
+ */
+template <int LOG_SCALE>
+class basic_hashed_perceptron : public champsim::modules::branch_predictor
 {
   using bits = champsim::data::bits;                 // saves some typing
   constexpr static std::size_t NTABLES = 16;         // this many tables
   constexpr static bits MAXHIST{232};                // maximum history length
   constexpr static bits MINHIST{3};                  // minimum history length (for table 1; table 0 is biases)
-  constexpr static std::size_t TABLE_SIZE = 1 << 12; // 12-bit indices for the tables
+  constexpr static std::size_t TABLE_SIZE = scale_size(1 << 12, LOG_SCALE); // 12-bit indices for the tables, by default
   constexpr static bits TABLE_INDEX_BITS{champsim::msl::lg2(TABLE_SIZE)};
   constexpr static int THRESHOLD = 1;
 
@@ -25,32 +34,76 @@ class hashed_perceptron : public champsim::modules::branch_predictor
       bits{},   MINHIST,  bits{4},  bits{6},  bits{8},  bits{10},  bits{14},  bits{19},
       bits{26}, bits{36}, bits{49}, bits{67}, bits{91}, bits{125}, bits{170}, MAXHIST}; // geometric global history lengths
 
-  // tables of 8-bit weights
-  std::array<std::array<champsim::msl::sfwcounter<8>, TABLE_SIZE>, NTABLES> tables{};
+  // tables of 8-bit weights, one after another, so that one weight from each can be gathered together
+  static_assert(NTABLES % gather_kernel::GATHER_WIDTH == 0);
+  std::array<int8_t, NTABLES * TABLE_SIZE + gather_kernel::GATHER_PADDING> tables{};
 
-  // words that store the global history
-  using history_type = folded_shift_register<TABLE_INDEX_BITS>;
-  std::array<history_type, NTABLES> ghist_words = []() {
-    decltype(ghist_words) retval;
-    std::transform(std::cbegin(history_lengths), std::cend(history_lengths), std::begin(retval), [](const auto len) { return history_type{len}; });
-    return retval;
+  // the results of predictions not yet resolved, enough for every instruction in flight when branches are resolved at retire
+  constexpr static std::size_t NUM_UPDATE_ENTRIES = MAX_PREDICTIONS_IN_FLIGHT;
+
+  // the global history, updated as branches are predicted, with one fold of each length
+  constexpr static std::size_t HISTORY_RING_BITS = 2048;
+  static_assert(HISTORY_RING_BITS >= champsim::to_underlying(MAXHIST) + NUM_UPDATE_ENTRIES);
+  using history_type = champsim::msl::speculative_history<HISTORY_RING_BITS, NTABLES>;
+  history_type ghist = []() {
+    std::array<typename history_type::fold_shape, NTABLES> shapes;
+    std::transform(std::cbegin(history_lengths), std::cend(history_lengths), std::begin(shapes), [](const auto len) {
+      return typename history_type::fold_shape{champsim::to_underlying(len), champsim::to_underlying(TABLE_INDEX_BITS)};
+    });
+    return history_type{shapes};
   }();
 
   int theta = 10;
   int tc = 0; // counter for threshold setting algorithm
+  int last_yout = 0; // the perceptron sum of the last prediction
 
   struct perceptron_result {
-    std::array<uint64_t, std::tuple_size_v<decltype(history_lengths)>> indices = {}; // remember the indices into the tables from prediction to update
-    int yout = 0;                                                                    // perceptron sum
+    std::array<int32_t, std::tuple_size_v<decltype(history_lengths)>> offsets = {}; // remember the offsets of the weights from prediction to update
+    int yout = 0;                                                                   // perceptron sum
+    typename history_type::checkpoint checkpoint = {};                               // the history before this branch was pushed into it
+    bool in_history = false;                                                        // whether this was a branch, so that it was pushed
   };
 
-  perceptron_result last_result{};
+  using state_buffer_type = champsim::msl::sequence_ring<perceptron_result, NUM_UPDATE_ENTRIES>;
+  state_buffer_type results;
 
 public:
   using branch_predictor::branch_predictor;
-  bool predict_branch(champsim::address pc);
-  void last_branch_result(champsim::address pc, champsim::address branch_target, bool taken, uint8_t branch_type);
+  bool predict_branch(prediction_id id, champsim::address pc, champsim::address predicted_target, bool always_taken, uint8_t branch_type);
+  void last_branch_result(prediction_id id, champsim::address pc, champsim::address branch_target, bool taken, uint8_t branch_type);
+  void repair_branch_history(prediction_id id, champsim::address pc, champsim::address branch_target, bool taken, uint8_t branch_type);
+
+  // Without identifiers, each branch is resolved before the next is predicted
+  bool predict_branch(champsim::address pc) { return predict_branch(results.last() + 1, pc, champsim::address{}, false, BRANCH_CONDITIONAL); }
+  void last_branch_result(champsim::address pc, champsim::address branch_target, bool taken, uint8_t branch_type)
+  {
+    last_branch_result(results.last(), pc, branch_target, taken, branch_type);
+  }
   void adjust_threshold(bool correct);
+
+  // the magnitude of the last perceptron sum relative to theta, below which a correct prediction is still trained, up to 1
+  [[nodiscard]] float prediction_confidence() const
+  {
+    return std::min(1.0f, static_cast<float>(std::abs(last_yout)) / static_cast<float>(std::max(theta, 1)));
+  }
+
+  // the weights and the longest history
+  [[nodiscard]] static constexpr std::size_t storage_bits() { return NTABLES * TABLE_SIZE * 8 + champsim::to_underlying(MAXHIST); }
+
+  template <typename Archive>
+  void snapshot_branch_predictor(Archive& archive)
+  {
+    archive(tables);
+    ghist.snapshot(archive);
+    archive(theta);
+    archive(tc);
+  }
+};
+
+class hashed_perceptron : public basic_hashed_perceptron<0>
+{
+public:
+  using basic_hashed_perceptron::basic_hashed_perceptron;
 };
 
 #endif
@@ -0,0 +1,176 @@
+#ifndef ARM_GATE_H
+#define ARM_GATE_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "msl/bits.h"
+
+/**
+ * Per-bucket gates that stop a meta predictor from evaluating the arms that cannot win.
+ *
+ * Each bucket counts, for every arm it evaluated, how many branches the arm predicted and how
+ * many of those it got right, and from these bounds each arm's accuracy with a Hoeffding
+ * interval. An arm is dominated when the upper bound of its accuracy is below the lower bound
+ * of another arm's. The dominated arms of a bucket are gated: they are not evaluated, and so
+ * not trained, on its branches. Which arms are active is kept in a bitmask per bucket, and the
+ * bounds are compared every CHECK_INTERVAL branches of the bucket rather than on every one.
+ * The bounds are fixed point, with the half-width for each number of evaluations looked up in a
+ * table that is computed once, so no square root is taken as branches resolve.
+ *
+ * Every PROBE_INTERVAL branches of a bucket with a gated arm, every arm is evaluated once more
+ * as a probe, so a gated arm whose accuracy has since risen above the leader's lower bound is
+ * made active again. The counts are halved once an arm has been evaluated WINDOW times, so the
+ * bounds follow the recent behaviour of the bucket and never become narrower than that allows.
+ *
+ * The gates are held in a flat array indexed by the bandit table slot, next to (not inside)
+ * the bandit state, and a slot's gate is reset when the table allocates the slot to a branch.
+ */
+template <std::size_t NUM_ARMS>
+class ArmGateTable {
+public:
+    using arm_mask_type = uint8_t;
+    static_assert(NUM_ARMS <= std::numeric_limits<arm_mask_type>::digits, "Every arm must have a bit in the active-arm mask");
+
+    static constexpr arm_mask_type ALL_ARMS = static_cast<arm_mask_type>((1u << NUM_ARMS) - 1);
+    static constexpr uint16_t WINDOW = 4096;
+    static constexpr uint8_t PROBE_INTERVAL = 128;
+    static constexpr uint8_t CHECK_INTERVAL = 16;
+
+    // The half-width of an accuracy bound is sqrt(BOUND_WIDTH / evaluations): ln(1 / delta) / 2 for a bound that holds with delta of about 0.25%
+    static constexpr double BOUND_WIDTH = 3.0;
+    static constexpr int BOUND_FRACTION_BITS = 16;
+
+    // What changed when a branch was recorded, counted in arms
+    struct change_type {
+        std::size_t gated = 0;
+        std::size_t reopened = 0;
+    };
+
+    explicit ArmGateTable(std::size_t num_buckets);
+
+    // Forget what the bucket in this slot learned, when it is allocated to another branch
+    void reset(std::size_t bucket) { entries_[bucket] = entry_type{}; }
+
+    // The arms to evaluate for the next branch of a bucket: its active arms, or every arm on a probe
+    arm_mask_type evaluate(std::size_t bucket);
+
+    // The arms that are active in a bucket, and the arm with the highest lower bound among them
+    arm_mask_type active(std::size_t bucket) const { return entries_[bucket].active; }
+    int leader(std::size_t bucket) const { return entries_[bucket].leader; }
+
+    // A branch resolved in a bucket, where the evaluated arms were correct or not, and the gates are updated with it
+    change_type record(std::size_t bucket, arm_mask_type evaluated, const std::array<bool, NUM_ARMS>& arm_correct);
+
+    // The bits a gate would take in hardware: the counts, the mask, the leader and the two countdowns
+    static constexpr std::size_t entry_bits() {
+        return NUM_ARMS * 2 * static_cast<std::size_t>(champsim::msl::lg2(WINDOW)) + NUM_ARMS
+               + static_cast<std::size_t>(champsim::msl::lg2(champsim::msl::next_pow2(NUM_ARMS)))
+               + static_cast<std::size_t>(champsim::msl::lg2(PROBE_INTERVAL)) + static_cast<std::size_t>(champsim::msl::lg2(CHECK_INTERVAL));
+    }
+    std::size_t storage_bits() const { return std::size(entries_) * entry_bits(); }
+
+    // Save or restore the gates with a snapshot archive
+    template <typename Archive>
+    void snapshot(Archive& archive) {
+        archive(entries_);
+    }
+
+private:
+    struct entry_type {
+        std::array<uint16_t, NUM_ARMS> evaluations{};
+        std::array<uint16_t, NUM_ARMS> correct{};
+        arm_mask_type active = ALL_ARMS;
+        uint8_t leader = 0;
+        uint8_t until_probe = PROBE_INTERVAL;
+        uint8_t until_check = CHECK_INTERVAL;
+    };
+
+    using bound_type = int32_t;
+
+    // The half-width of the bounds for each number of evaluations, which is always below WINDOW
+    static inline const std::array<bound_type, WINDOW> bound_widths_ = [] {
+        std::array<bound_type, WINDOW> widths{};
+        for (std::size_t n = 1; n < WINDOW; ++n)
+            widths[n] = static_cast<bound_type>(std::lround(std::ldexp(std::sqrt(BOUND_WIDTH / static_cast<double>(n)), BOUND_FRACTION_BITS)));
+        return widths;
+    }();
+
+    std::vector<entry_type> entries_;
+};
+
+// --- ArmGateTable Implementation ---
+
+template <std::size_t NUM_ARMS>
+ArmGateTable<NUM_ARMS>::ArmGateTable(std::size_t num_buckets)
+    : entries_(num_buckets) {}
+
+template <std::size_t NUM_ARMS>
+auto ArmGateTable<NUM_ARMS>::evaluate(std::size_t bucket) -> arm_mask_type {
+    auto& entry = entries_[bucket];
+    if (entry.active == ALL_ARMS)
+        return ALL_ARMS;
+    if (--entry.until_probe == 0) {
+        entry.until_probe = PROBE_INTERVAL;
+        return ALL_ARMS;
+    }
+    return entry.active;
+}
+
+template <std::size_t NUM_ARMS>
+auto ArmGateTable<NUM_ARMS>::record(std::size_t bucket, arm_mask_type evaluated, const std::array<bool, NUM_ARMS>& arm_correct) -> change_type {
+    auto& entry = entries_[bucket];
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        if ((evaluated >> i) & 1u) {
+            ++entry.evaluations[i];
+            entry.correct[i] += arm_correct[i];
+            if (entry.evaluations[i] == WINDOW) {
+                entry.evaluations[i] /= 2;
+                entry.correct[i] /= 2;
+            }
+        }
+    }
+
+    // the bounds are only compared every CHECK_INTERVAL branches, and on probes
+    const bool probe = (evaluated & ~entry.active) != 0;
+    if (--entry.until_check != 0 && !probe)
+        return {};
+    entry.until_check = CHECK_INTERVAL;
+
+    // an arm that has not been evaluated is unbounded, so it is never gated
+    std::array<bound_type, NUM_ARMS> lower{};
+    std::array<bound_type, NUM_ARMS> upper{};
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        if (entry.evaluations[i] == 0) {
+            lower[i] = 0;
+            upper[i] = std::numeric_limits<bound_type>::max();
+        } else {
+            const auto mean = static_cast<bound_type>((bound_type{entry.correct[i]} << BOUND_FRACTION_BITS) / entry.evaluations[i]);
+            lower[i] = mean - bound_widths_[entry.evaluations[i]];
+            upper[i] = mean + bound_widths_[entry.evaluations[i]];
+        }
+    }
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        if (lower[i] > lower[entry.leader])
+            entry.leader = static_cast<uint8_t>(i);
+    }
+
+    arm_mask_type active = 0;
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        if (upper[i] >= lower[entry.leader])
+            active = static_cast<arm_mask_type>(active | (1u << i));
+    }
+
+    change_type result;
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        result.gated += ((entry.active >> i) & 1u) && !((active >> i) & 1u);
+        result.reopened += !((entry.active >> i) & 1u) && ((active >> i) & 1u);
+    }
+    entry.active = active;
+    return result;
+}
+
+#endif // ARM_GATE_H
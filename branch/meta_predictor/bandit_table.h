@@ -0,0 +1,166 @@
+#ifndef BANDIT_TABLE_H
+#define BANDIT_TABLE_H
+
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include "../../inc/address.h"
+#include "msl/bits.h"
+
+/**
+ * A fixed-size, set-associative table of per-branch bandit state.
+ *
+ * Branches are hashed into a set and identified within it by a partial tag, so the
+ * table never grows past num_sets * num_ways entries. Tags, replacement state and
+ * bandit state are held in separate flat arrays so that a lookup only touches the
+ * tags of one set. When a set is full, the least-recently-used way is evicted and its
+ * state is reset to the prototype given at construction.
+ *
+ * Because tags are partial, two branches may share an entry. Those aliases are counted
+ * (using the full address of the branch that allocated the entry) but not prevented,
+ * as they would not be in hardware.
+ */
+template <typename State>
+class BanditTable {
+public:
+    BanditTable(std::size_t num_sets, std::size_t num_ways, std::size_t tag_bits, State prototype);
+
+    // Find the bandit state for this branch, allocating an entry if it is not present. Repeating the
+    // most recent lookup, as the update following a prediction does, is not counted as another access.
+    State& lookup(champsim::address ip);
+
+    std::size_t num_sets() const { return num_sets_; }
+    std::size_t num_ways() const { return num_ways_; }
+
+    uint64_t hits() const { return hits_; }
+    uint64_t misses() const { return misses_; }
+    uint64_t evictions() const { return evictions_; }
+    uint64_t aliases() const { return aliases_; }
+
+    // The bits an entry would take in hardware: its tag, valid bit, replacement state and bandit state.
+    // The allocating branch's full address is only kept for alias accounting, so it is not counted.
+    static constexpr std::size_t entry_bits(std::size_t num_ways, std::size_t tag_bits) {
+        return tag_bits + 1 + static_cast<std::size_t>(champsim::msl::lg2(num_ways)) + 8 * sizeof(State);
+    }
+    std::size_t storage_bits() const { return num_sets_ * num_ways_ * entry_bits(num_ways_, tag_bits_); }
+
+    // The slot of the most recent lookup, whether that lookup allocated it, and the address of the branch that allocated a slot
+    std::size_t last_slot() const { return last_slot_; }
+    bool last_allocated() const { return last_allocated_; }
+    uint64_t owner(std::size_t slot) const { return owners_[slot]; }
+
+    // Save or restore the table with a snapshot archive. State must be trivially copyable.
+    template <typename Archive>
+    void snapshot(Archive& archive);
+
+private:
+    std::size_t num_sets_;
+    std::size_t num_ways_;
+    std::size_t set_bits_;
+    std::size_t tag_bits_;
+    uint64_t tag_mask_;
+    State prototype_;
+
+    std::vector<uint64_t> tags_;
+    std::vector<uint64_t> last_used_; // 0 marks an invalid way
+    std::vector<uint64_t> owners_;    // full address of the allocating branch, for alias accounting only
+    std::vector<State> states_;
+
+    uint64_t access_count_ = 0;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+    uint64_t evictions_ = 0;
+    uint64_t aliases_ = 0;
+
+    // The most recent lookup, so that the update following a prediction does not search again
+    uint64_t last_ip_ = 0;
+    std::size_t last_slot_ = 0;
+    bool last_valid_ = false;
+    bool last_allocated_ = false;
+
+    std::size_t find_slot(uint64_t ip);
+};
+
+template <typename State>
+BanditTable<State>::BanditTable(std::size_t num_sets, std::size_t num_ways, std::size_t tag_bits, State prototype)
+    : num_sets_(num_sets),
+      num_ways_(num_ways),
+      set_bits_(static_cast<std::size_t>(champsim::msl::lg2(num_sets))),
+      tag_bits_(tag_bits),
+      tag_mask_(champsim::msl::bitmask(champsim::data::bits{tag_bits})),
+      prototype_(prototype),
+      tags_(num_sets * num_ways, 0),
+      last_used_(num_sets * num_ways, 0),
+      owners_(num_sets * num_ways, 0),
+      states_(num_sets * num_ways, prototype)
+{
+    if (num_sets == 0 || (num_sets & (num_sets - 1)) != 0)
+        throw std::range_error{"Bandit table sets is not a power of 2"};
+    if (num_ways == 0)
+        throw std::range_error{"Bandit table ways is not positive"};
+}
+
+template <typename State>
+template <typename Archive>
+void BanditTable<State>::snapshot(Archive& archive) {
+    archive(tags_);
+    archive(last_used_);
+    archive(owners_);
+    archive(states_);
+    archive(access_count_);
+    archive(hits_);
+    archive(misses_);
+    archive(evictions_);
+    archive(aliases_);
+    last_valid_ = false;
+}
+
+template <typename State>
+State& BanditTable<State>::lookup(champsim::address ip) {
+    const auto raw_ip = ip.to<uint64_t>();
+    if (last_valid_ && last_ip_ == raw_ip) {
+        // the same access as the lookup it repeats, so it was already counted
+        last_allocated_ = false;
+    } else {
+        last_slot_ = find_slot(raw_ip);
+        last_ip_ = raw_ip;
+        last_valid_ = true;
+    }
+    last_used_[last_slot_] = ++access_count_;
+    return states_[last_slot_];
+}
+
+template <typename State>
+std::size_t BanditTable<State>::find_slot(uint64_t ip) {
+    const uint64_t set = (ip ^ (ip >> set_bits_)) & (num_sets_ - 1);
+    const uint64_t tag = (ip >> set_bits_) & tag_mask_;
+    const std::size_t begin = set * num_ways_;
+    const std::size_t end = begin + num_ways_;
+
+    std::size_t victim = begin;
+    for (std::size_t i = begin; i < end; ++i) {
+        if (last_used_[i] != 0 && tags_[i] == tag) {
+            ++hits_;
+            if (owners_[i] != ip)
+                ++aliases_;
+            last_allocated_ = false;
+            return i;
+        }
+        if (last_used_[i] < last_used_[victim])
+            victim = i;
+    }
+
+    ++misses_;
+    if (last_used_[victim] != 0)
+        ++evictions_;
+
+    tags_[victim] = tag;
+    owners_[victim] = ip;
+    states_[victim] = prototype_;
+    last_allocated_ = true;
+    return victim;
+}
+
+#endif // BANDIT_TABLE_H
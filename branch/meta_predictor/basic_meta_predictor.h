@@ -0,0 +1,592 @@
+#ifndef BASIC_META_PREDICTOR_H
+#define BASIC_META_PREDICTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <fmt/core.h>
+
+#include "../../inc/address.h"
+#include "instruction.h"
+#include "modules.h"
+#include "msl/sequence_ring.h"
+
+#include "arm_gate.h"
+#include "bandit_table.h"
+#include "meta_predictor_telemetry.h"
+
+// How the arms are consulted and trained
+enum class meta_training_mode {
+    chosen_arm, // only the arm the bandit selects predicts and is trained
+    shadow,     // every arm predicts in one fused pass, and every arm and its bandit value are trained
+    oracle,     // as in shadow mode, and the chooser is also measured against the per-branch oracle and the best fixed arm per address
+    gated,      // as in shadow mode, but each bucket stops predicting with and training the arms that are dominated in it, except on probes
+};
+
+namespace meta_predictor_detail {
+template <typename T, typename... Args>
+auto vote_member_impl(int) -> decltype(std::declval<T>().vote(std::declval<Args>()...), std::true_type{});
+template <typename, typename...>
+auto vote_member_impl(long) -> std::false_type;
+
+// A policy that combines every arm's prediction instead of selecting one arm
+template <typename T, typename... Args>
+constexpr bool has_vote = decltype(vote_member_impl<T, Args...>(0))::value;
+
+template <typename T, typename... Args>
+auto value_member_impl(int) -> decltype(std::declval<T>().value(std::declval<Args>()...), std::true_type{});
+template <typename, typename...>
+auto value_member_impl(long) -> std::false_type;
+
+// A policy that exposes its estimate of each arm's value, in the units of its rewards
+template <typename T, typename... Args>
+constexpr bool has_value = decltype(value_member_impl<T, Args...>(0))::value;
+
+template <typename T>
+auto confidence_member_impl(int) -> decltype(std::declval<T>().prediction_confidence(), std::true_type{});
+template <typename>
+auto confidence_member_impl(long) -> std::false_type;
+
+// An arm that reports how confident it was in its last prediction
+template <typename T>
+constexpr bool has_prediction_confidence = decltype(confidence_member_impl<T>(0))::value;
+
+// Confidence is kept in this many levels, from 0 for a guess to CONFIDENCE_LEVELS - 1
+constexpr std::size_t CONFIDENCE_LEVELS = 4;
+
+using prediction_id = champsim::modules::branch_predictor::prediction_id;
+
+// Predict with an arm, passing the identifier of the prediction and the branch type if the arm takes them
+template <typename Arm>
+bool predict_one(Arm& arm, prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) {
+    if constexpr (champsim::modules::branch_predictor::has_predict_branch<Arm&, prediction_id, champsim::address, champsim::address, bool, uint8_t>)
+        return arm.predict_branch(id, ip, predicted_target, always_taken, branch_type);
+    else if constexpr (champsim::modules::branch_predictor::has_predict_branch<Arm&, prediction_id, champsim::address>)
+        return arm.predict_branch(id, ip);
+    else
+        return arm.predict_branch(ip);
+}
+
+// The confidence of an arm in the prediction it just made, as a level. An arm that does not report it is taken to be fully confident.
+template <typename Arm>
+uint8_t confidence_one(const Arm& arm) {
+    if constexpr (has_prediction_confidence<const Arm&>) {
+        const auto level = static_cast<std::size_t>(arm.prediction_confidence() * CONFIDENCE_LEVELS);
+        return static_cast<uint8_t>(std::min(level, CONFIDENCE_LEVELS - 1));
+    } else {
+        return static_cast<uint8_t>(CONFIDENCE_LEVELS - 1);
+    }
+}
+
+// Train an arm, passing the identifier of the prediction if the arm takes one
+template <typename Arm>
+void train_one(Arm& arm, prediction_id id, champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type) {
+    if constexpr (champsim::modules::branch_predictor::has_last_branch_result<Arm&, prediction_id, champsim::address, champsim::address, bool, uint8_t>)
+        arm.last_branch_result(id, ip, branch_target, taken, branch_type);
+    else
+        arm.last_branch_result(ip, branch_target, taken, branch_type);
+}
+
+// Repair the speculative history of an arm, if it keeps one
+template <typename Arm>
+void repair_one(Arm& arm, prediction_id id, champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type) {
+    if constexpr (champsim::modules::branch_predictor::has_repair_branch_history<Arm&, prediction_id, champsim::address, champsim::address, bool,
+                                                                                  uint8_t>)
+        arm.repair_branch_history(id, ip, branch_target, taken, branch_type);
+}
+} // namespace meta_predictor_detail
+
+/**
+ * A meta predictor that chooses, per branch, which of its arms makes the prediction.
+ *
+ * The arms are held by value in a tuple, so they are constructed in the same allocation
+ * as the meta predictor and are destroyed with it. The choice of arm is made by a bandit
+ * policy, shared by the whole predictor, acting on per-bucket state kept in a BanditTable.
+ * Calls to the chosen arm are dispatched with a fold over the arm indices, which the
+ * compiler turns into a short compare chain with every arm's predict inlined; adding an
+ * arm only needs a new template argument.
+ *
+ * In shadow mode, every arm predicts on every branch and their predictions are cached, so
+ * each arm sees the whole branch stream and the bandit learns the value of every arm, not
+ * only the one it chose.
+ *
+ * The oracle mode predicts and trains as in shadow mode, so it costs no more, and also
+ * measures the headroom left by the bandit: how often any arm was correct, and how often the
+ * best fixed arm for each branch address was, next to how often the bandit's choice was. The
+ * prediction is still the bandit's, since the oracle needs the outcome to choose.
+ *
+ * The gated mode learns as in shadow mode at a cost closer to that of the chosen_arm mode.
+ * Each bucket gates the arms that are dominated in it, so that only its active arms predict
+ * and are trained, with every arm evaluated again on occasional probes (see ArmGateTable).
+ * If the bandit chooses a gated arm, the bucket's leading arm predicts in its place.
+ *
+ * Branches may be resolved some time after they are predicted, and out of order, so what
+ * each prediction depended on is kept in a ring, by the identifier of the prediction, until
+ * its branch is resolved. The identifier is passed on to the arms that take one, so that
+ * they can do the same. A misprediction is passed on to the arms that predicted the branch,
+ * so that those that update their history speculatively can repair it.
+ *
+ * An arm may report how confident it was in the prediction it just made, from 0 to 1, with
+ * prediction_confidence(), from what it computed to predict. With confidence rewards, the
+ * reward for a prediction is scaled by the arm's confidence in it, from half at the lowest
+ * level to all of it at the highest, so a strongly wrong arm is penalized more than a weakly
+ * wrong one. With confidence selection, when every arm predicts, the most confident of the
+ * arms whose values are close to that of the bandit's choice makes the prediction instead;
+ * this needs a bandit that exposes value(state, arm).
+ *
+ * \tparam Bandit The bandit policy. It must provide a state_type and a reward_type, a static
+ * make_reward(double), and the members select_arm(state) and update(state, arm, reward).
+ * Alternatively, a voting policy provides vote(state, predictions) and update_votes(state,
+ * predictions, taken) in place of the last two, where predictions holds every arm's prediction.
+ * The vote is the prediction, every arm predicts and is trained on every branch, and the
+ * training mode is not used.
+ * \tparam Arms The branch predictors to choose between.
+ */
+template <typename Bandit, typename... Arms>
+class basic_meta_predictor {
+public:
+    static constexpr std::size_t NUM_ARMS = sizeof...(Arms);
+
+    using bandit_state_type = typename Bandit::state_type;
+    using reward_type = typename Bandit::reward_type;
+    using predictions_type = std::array<bool, NUM_ARMS>;
+    using confidences_type = std::array<uint8_t, NUM_ARMS>;
+    using arm_mask_type = typename ArmGateTable<NUM_ARMS>::arm_mask_type;
+
+    static constexpr bool IS_VOTING = meta_predictor_detail::has_vote<Bandit&, bandit_state_type&, const predictions_type&>;
+
+    using prediction_id = meta_predictor_detail::prediction_id;
+
+    // What a prediction depended on, kept until its branch is resolved
+    struct in_flight_state {
+        int chosen_arm = -1;                // the arm that made the prediction, or -1 for a vote
+        bool prediction = false;
+        predictions_type arm_predictions{}; // the prediction of each arm that predicted
+        confidences_type arm_confidences{}; // the confidence level of each arm that predicted
+        arm_mask_type evaluated_arms = 0;   // the arms that predicted
+        bool probe = false;                 // whether every arm predicted to re-check the gated arms of the bucket
+    };
+
+    static constexpr std::size_t CONFIDENCE_LEVELS = meta_predictor_detail::CONFIDENCE_LEVELS;
+
+    // How close, in rewards, the values of two arms must be for confidence selection to choose between them
+    static constexpr double CLOSE_VALUE_MARGIN = 0.125;
+
+    static constexpr std::size_t NUM_IN_FLIGHT = champsim::modules::branch_predictor::MAX_PREDICTIONS_IN_FLIGHT;
+
+    basic_meta_predictor(O3_CPU* cpu, std::size_t bandit_sets, std::size_t bandit_ways, std::size_t bandit_tag_bits, Bandit bandit,
+                         meta_training_mode mode = meta_training_mode::chosen_arm);
+
+    void initialize_branch_predictor();
+    bool predict_branch(prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type);
+    void last_branch_result(prediction_id id,
+                            champsim::address ip,
+                            champsim::address branch_target,
+                            bool taken,
+                            uint8_t branch_type);
+    void repair_branch_history(prediction_id id,
+                               champsim::address ip,
+                               champsim::address branch_target,
+                               bool taken,
+                               uint8_t branch_type);
+
+    // Without identifiers, each branch is resolved before the next is predicted
+    bool predict_branch(champsim::address ip) { return predict_branch(in_flight_.last() + 1, ip, champsim::address{}, false, BRANCH_CONDITIONAL); }
+    void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type) {
+        last_branch_result(in_flight_.last(), ip, branch_target, taken, branch_type);
+    }
+
+    // Save or restore the bandit table and every arm that supports snapshots
+    template <typename Archive>
+    void snapshot_branch_predictor(Archive& archive);
+
+    // The rewards given to the bandit for a correct and an incorrect prediction
+    void set_rewards(double correct, double incorrect);
+
+    // Whether rewards are scaled by the confidence of the arm in its prediction
+    void set_confidence_rewards(bool enabled) { confidence_rewards_ = enabled; }
+
+    // Whether the most confident of the arms with close values predicts, when every arm predicts
+    void set_confidence_selection(bool enabled) {
+        static_assert(meta_predictor_detail::has_value<const Bandit&, const bandit_state_type&, int>,
+                      "Confidence selection compares arm values, so the bandit must provide value(state, arm)");
+        confidence_selection_ = enabled;
+    }
+
+    meta_predictor_stats meta_predictor_telemetry() const { return telemetry_.stats(); }
+    void begin_phase_branch_predictor() { telemetry_.begin_phase(); }
+    void branch_predictor_final_stats() const;
+
+    // The storage of every arm that reports it, and of the bandit table
+    std::size_t storage_bits() const;
+
+    template <std::size_t I>
+    auto& arm() { return std::get<I>(arms_); }
+
+    const BanditTable<bandit_state_type>& bandits() const { return bandit_buckets_; }
+    const ArmGateTable<NUM_ARMS>& gates() const { return gates_; }
+
+protected:
+    std::tuple<Arms...> arms_;
+    Bandit bandit_;
+    BanditTable<bandit_state_type> bandit_buckets_;
+    ArmGateTable<NUM_ARMS> gates_;
+
+    meta_training_mode mode_;
+
+    champsim::msl::sequence_ring<in_flight_state, NUM_IN_FLIGHT> in_flight_;
+
+    reward_type reward_correct_ = Bandit::make_reward(1.0);
+    reward_type reward_incorrect_ = Bandit::make_reward(-0.5);
+
+    // The rewards scaled by each confidence level, so that no scaling is done per branch
+    std::array<reward_type, CONFIDENCE_LEVELS> confident_correct_{};
+    std::array<reward_type, CONFIDENCE_LEVELS> confident_incorrect_{};
+    reward_type close_margin_ = Bandit::make_reward(CLOSE_VALUE_MARGIN);
+    bool confidence_rewards_ = false;
+    bool confidence_selection_ = false;
+
+    reward_type reward(bool correct, uint8_t confidence) const;
+
+    MetaPredictorTelemetry<NUM_ARMS> telemetry_;
+
+private:
+    // Whether every arm predicts and is trained on every branch
+    bool every_arm_predicts() const { return IS_VOTING || mode_ == meta_training_mode::shadow || mode_ == meta_training_mode::oracle; }
+
+    // The slot of the last bandit table lookup, with its gate reset if the lookup allocated it
+    std::size_t gated_slot();
+
+    // The arm with the highest confidence among those whose value is close to the chosen arm's
+    int most_confident_close_arm(const bandit_state_type& state, int chosen, const confidences_type& confidences) const;
+
+    template <std::size_t... Is>
+    bool predict_arm(int arm, prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type,
+                     confidences_type& confidences, std::index_sequence<Is...>);
+
+    template <std::size_t... Is>
+    void predict_all(prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type,
+                     predictions_type& predictions, confidences_type& confidences, std::index_sequence<Is...>);
+
+    template <std::size_t... Is>
+    void predict_active(arm_mask_type arms, prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken,
+                        uint8_t branch_type, predictions_type& predictions, confidences_type& confidences, std::index_sequence<Is...>);
+
+    template <std::size_t... Is>
+    void train_all(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type,
+                   std::index_sequence<Is...>);
+
+    template <std::size_t... Is>
+    void train_arm(int arm, prediction_id id, champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type,
+                   std::index_sequence<Is...>);
+
+    template <std::size_t... Is>
+    void train_active(arm_mask_type arms, prediction_id id, champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type,
+                      std::index_sequence<Is...>);
+
+    template <std::size_t... Is>
+    void repair_all(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type,
+                    std::index_sequence<Is...>);
+
+    template <std::size_t... Is>
+    void repair_arm(int arm, prediction_id id, champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type,
+                    std::index_sequence<Is...>);
+
+    template <std::size_t... Is>
+    void repair_active(arm_mask_type arms, prediction_id id, champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type,
+                       std::index_sequence<Is...>);
+};
+
+template <typename Bandit, typename... Arms>
+basic_meta_predictor<Bandit, Arms...>::basic_meta_predictor(O3_CPU* cpu, std::size_t bandit_sets, std::size_t bandit_ways, std::size_t bandit_tag_bits,
+                                                            Bandit bandit, meta_training_mode mode)
+    : arms_(Arms{cpu}...),
+      bandit_(bandit),
+      bandit_buckets_(bandit_sets, bandit_ways, bandit_tag_bits, bandit_state_type{}),
+      gates_(bandit_sets * bandit_ways),
+      mode_(mode),
+      telemetry_(bandit_sets * bandit_ways) {
+    set_rewards(1.0, -0.5);
+}
+
+template <typename Bandit, typename... Arms>
+void basic_meta_predictor<Bandit, Arms...>::set_rewards(double correct, double incorrect) {
+    reward_correct_ = Bandit::make_reward(correct);
+    reward_incorrect_ = Bandit::make_reward(incorrect);
+    for (std::size_t level = 0; level < CONFIDENCE_LEVELS; ++level) {
+        const auto scale = 0.5 + 0.5 * static_cast<double>(level) / (CONFIDENCE_LEVELS - 1);
+        confident_correct_[level] = Bandit::make_reward(correct * scale);
+        confident_incorrect_[level] = Bandit::make_reward(incorrect * scale);
+    }
+}
+
+template <typename Bandit, typename... Arms>
+auto basic_meta_predictor<Bandit, Arms...>::reward(bool correct, uint8_t confidence) const -> reward_type {
+    if (confidence_rewards_)
+        return correct ? confident_correct_[confidence] : confident_incorrect_[confidence];
+    return correct ? reward_correct_ : reward_incorrect_;
+}
+
+template <typename Bandit, typename... Arms>
+int basic_meta_predictor<Bandit, Arms...>::most_confident_close_arm(const bandit_state_type& state, int chosen,
+                                                                    const confidences_type& confidences) const {
+    if constexpr (meta_predictor_detail::has_value<const Bandit&, const bandit_state_type&, int>) {
+        const auto chosen_value = bandit_.value(state, chosen);
+        int best = chosen;
+        for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+            const auto value = bandit_.value(state, static_cast<int>(i));
+            const bool close = (value > chosen_value) ? (value - chosen_value <= close_margin_) : (chosen_value - value <= close_margin_);
+            if (close && confidences[i] > confidences[static_cast<std::size_t>(best)])
+                best = static_cast<int>(i);
+        }
+        return best;
+    } else {
+        return chosen;
+    }
+}
+
+template <typename Bandit, typename... Arms>
+std::size_t basic_meta_predictor<Bandit, Arms...>::gated_slot() {
+    const auto slot = bandit_buckets_.last_slot();
+    if (bandit_buckets_.last_allocated())
+        gates_.reset(slot);
+    return slot;
+}
+
+template <typename Bandit, typename... Arms>
+void basic_meta_predictor<Bandit, Arms...>::initialize_branch_predictor() {
+    auto initialize_one = [](auto& arm) {
+        if constexpr (champsim::modules::branch_predictor::has_initialize<decltype(arm)>)
+            arm.initialize_branch_predictor();
+    };
+    std::apply([&](auto&... arm) { (..., initialize_one(arm)); }, arms_);
+}
+
+template <typename Bandit, typename... Arms>
+void basic_meta_predictor<Bandit, Arms...>::branch_predictor_final_stats() const {
+    fmt::print("Meta predictor bandit table hits: {} misses: {} evictions: {} aliases: {}\n", bandit_buckets_.hits(), bandit_buckets_.misses(),
+               bandit_buckets_.evictions(), bandit_buckets_.aliases());
+}
+
+template <typename Bandit, typename... Arms>
+std::size_t basic_meta_predictor<Bandit, Arms...>::storage_bits() const {
+    std::size_t total = bandit_buckets_.storage_bits();
+    auto storage_one = [&](const auto& arm) {
+        if constexpr (champsim::modules::branch_predictor::has_storage_bits<decltype(arm)>)
+            total += arm.storage_bits();
+    };
+    std::apply([&](const auto&... arm) { (..., storage_one(arm)); }, arms_);
+    if (mode_ == meta_training_mode::gated)
+        total += gates_.storage_bits();
+    return total;
+}
+
+template <typename Bandit, typename... Arms>
+template <typename Archive>
+void basic_meta_predictor<Bandit, Arms...>::snapshot_branch_predictor(Archive& archive) {
+    auto snapshot_one = [&](auto& arm) {
+        if constexpr (champsim::modules::branch_predictor::has_snapshot<decltype(arm), Archive&>)
+            arm.snapshot_branch_predictor(archive);
+    };
+    std::apply([&](auto&... arm) { (..., snapshot_one(arm)); }, arms_);
+    bandit_buckets_.snapshot(archive);
+    gates_.snapshot(archive);
+}
+
+template <typename Bandit, typename... Arms>
+template <std::size_t... Is>
+bool basic_meta_predictor<Bandit, Arms...>::predict_arm(int arm, prediction_id id, champsim::address ip, champsim::address predicted_target,
+                                                        bool always_taken, uint8_t branch_type, confidences_type& confidences,
+                                                        std::index_sequence<Is...>) {
+    bool prediction = false;
+    (void)((arm == static_cast<int>(Is)
+            && (prediction = meta_predictor_detail::predict_one(std::get<Is>(arms_), id, ip, predicted_target, always_taken, branch_type),
+                confidences[Is] = meta_predictor_detail::confidence_one(std::get<Is>(arms_)), true))
+           || ...);
+    return prediction;
+}
+
+template <typename Bandit, typename... Arms>
+template <std::size_t... Is>
+void basic_meta_predictor<Bandit, Arms...>::predict_all(prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken,
+                                                        uint8_t branch_type, predictions_type& predictions, confidences_type& confidences,
+                                                        std::index_sequence<Is...>) {
+    ((predictions[Is] = meta_predictor_detail::predict_one(std::get<Is>(arms_), id, ip, predicted_target, always_taken, branch_type),
+      confidences[Is] = meta_predictor_detail::confidence_one(std::get<Is>(arms_))),
+     ...);
+}
+
+template <typename Bandit, typename... Arms>
+template <std::size_t... Is>
+void basic_meta_predictor<Bandit, Arms...>::predict_active(arm_mask_type arms, prediction_id id, champsim::address ip, champsim::address predicted_target,
+                                                           bool always_taken, uint8_t branch_type, predictions_type& predictions,
+                                                           confidences_type& confidences, std::index_sequence<Is...>) {
+    (void)((((arms >> Is) & 1u)
+            && (predictions[Is] = meta_predictor_detail::predict_one(std::get<Is>(arms_), id, ip, predicted_target, always_taken, branch_type),
+                confidences[Is] = meta_predictor_detail::confidence_one(std::get<Is>(arms_)), true)),
+           ...);
+}
+
+template <typename Bandit, typename... Arms>
+template <std::size_t... Is>
+void basic_meta_predictor<Bandit, Arms...>::train_all(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken,
+                                                      uint8_t branch_type, std::index_sequence<Is...>) {
+    (meta_predictor_detail::train_one(std::get<Is>(arms_), id, ip, branch_target, taken, branch_type), ...);
+}
+
+template <typename Bandit, typename... Arms>
+template <std::size_t... Is>
+void basic_meta_predictor<Bandit, Arms...>::train_arm(int arm, prediction_id id, champsim::address ip, champsim::address branch_target, bool taken,
+                                                      uint8_t branch_type, std::index_sequence<Is...>) {
+    (void)((arm == static_cast<int>(Is) && (meta_predictor_detail::train_one(std::get<Is>(arms_), id, ip, branch_target, taken, branch_type), true))
+           || ...);
+}
+
+template <typename Bandit, typename... Arms>
+template <std::size_t... Is>
+void basic_meta_predictor<Bandit, Arms...>::train_active(arm_mask_type arms, prediction_id id, champsim::address ip, champsim::address branch_target,
+                                                         bool taken, uint8_t branch_type, std::index_sequence<Is...>) {
+    (void)((((arms >> Is) & 1u) && (meta_predictor_detail::train_one(std::get<Is>(arms_), id, ip, branch_target, taken, branch_type), true)), ...);
+}
+
+template <typename Bandit, typename... Arms>
+template <std::size_t... Is>
+void basic_meta_predictor<Bandit, Arms...>::repair_all(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken,
+                                                       uint8_t branch_type, std::index_sequence<Is...>) {
+    (meta_predictor_detail::repair_one(std::get<Is>(arms_), id, ip, branch_target, taken, branch_type), ...);
+}
+
+template <typename Bandit, typename... Arms>
+template <std::size_t... Is>
+void basic_meta_predictor<Bandit, Arms...>::repair_arm(int arm, prediction_id id, champsim::address ip, champsim::address branch_target, bool taken,
+                                                       uint8_t branch_type, std::index_sequence<Is...>) {
+    (void)((arm == static_cast<int>(Is) && (meta_predictor_detail::repair_one(std::get<Is>(arms_), id, ip, branch_target, taken, branch_type), true))
+           || ...);
+}
+
+template <typename Bandit, typename... Arms>
+template <std::size_t... Is>
+void basic_meta_predictor<Bandit, Arms...>::repair_active(arm_mask_type arms, prediction_id id, champsim::address ip, champsim::address branch_target,
+                                                          bool taken, uint8_t branch_type, std::index_sequence<Is...>) {
+    (void)((((arms >> Is) & 1u) && (meta_predictor_detail::repair_one(std::get<Is>(arms_), id, ip, branch_target, taken, branch_type), true)), ...);
+}
+
+template <typename Bandit, typename... Arms>
+bool basic_meta_predictor<Bandit, Arms...>::predict_branch(prediction_id id, champsim::address ip, champsim::address predicted_target,
+                                                           bool always_taken, uint8_t branch_type) {
+    // every instruction is predicted, but only branches may take a bucket or an in-flight entry
+    if (branch_type == NOT_BRANCH)
+        return false;
+
+    in_flight_state state;
+    if constexpr (IS_VOTING) {
+        predict_all(id, ip, predicted_target, always_taken, branch_type, state.arm_predictions, state.arm_confidences,
+                    std::index_sequence_for<Arms...>{});
+        state.evaluated_arms = ArmGateTable<NUM_ARMS>::ALL_ARMS;
+        state.prediction = bandit_.vote(bandit_buckets_.lookup(ip), state.arm_predictions);
+    } else {
+        auto& bandit_state = bandit_buckets_.lookup(ip);
+        state.chosen_arm = bandit_.select_arm(bandit_state);
+        if (every_arm_predicts()) {
+            predict_all(id, ip, predicted_target, always_taken, branch_type, state.arm_predictions, state.arm_confidences,
+                        std::index_sequence_for<Arms...>{});
+            if (confidence_selection_)
+                state.chosen_arm = most_confident_close_arm(bandit_state, state.chosen_arm, state.arm_confidences);
+            state.evaluated_arms = ArmGateTable<NUM_ARMS>::ALL_ARMS;
+            state.prediction = state.arm_predictions[state.chosen_arm];
+        } else if (mode_ == meta_training_mode::gated) {
+            const auto slot = gated_slot();
+            state.evaluated_arms = gates_.evaluate(slot);
+            state.probe = (state.evaluated_arms != gates_.active(slot));
+            if (((state.evaluated_arms >> state.chosen_arm) & 1u) == 0)
+                state.chosen_arm = gates_.leader(slot);
+            predict_active(state.evaluated_arms, id, ip, predicted_target, always_taken, branch_type, state.arm_predictions, state.arm_confidences,
+                           std::index_sequence_for<Arms...>{});
+            state.prediction = state.arm_predictions[state.chosen_arm];
+        } else {
+            state.prediction = predict_arm(state.chosen_arm, id, ip, predicted_target, always_taken, branch_type, state.arm_confidences,
+                                           std::index_sequence_for<Arms...>{});
+            state.evaluated_arms = static_cast<arm_mask_type>(1u << state.chosen_arm);
+            state.arm_predictions[state.chosen_arm] = state.prediction;
+        }
+    }
+    in_flight_.push(id, state);
+    return state.prediction;
+}
+
+template <typename Bandit, typename... Arms>
+void basic_meta_predictor<Bandit, Arms...>::repair_branch_history(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken,
+                                                                  uint8_t branch_type) {
+    // only the arms that predicted the branch pushed it into their histories
+    const auto* found = in_flight_.find(id);
+    if (found == nullptr)
+        return;
+    if (every_arm_predicts())
+        repair_all(id, ip, branch_target, taken, branch_type, std::index_sequence_for<Arms...>{});
+    else if (mode_ == meta_training_mode::gated)
+        repair_active(found->evaluated_arms, id, ip, branch_target, taken, branch_type, std::index_sequence_for<Arms...>{});
+    else
+        repair_arm(found->chosen_arm, id, ip, branch_target, taken, branch_type, std::index_sequence_for<Arms...>{});
+}
+
+template <typename Bandit, typename... Arms>
+void basic_meta_predictor<Bandit, Arms...>::last_branch_result(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken,
+                                                               uint8_t branch_type) {
+    const auto* found = in_flight_.find(id);
+    if (found == nullptr)
+        return; // what the prediction depended on was lost, so it cannot be trained
+    const auto prediction = *found;
+    in_flight_.erase(id);
+
+    auto& state = bandit_buckets_.lookup(ip);
+    const auto slot = bandit_buckets_.last_slot();
+    const auto owner = bandit_buckets_.owner(slot);
+    const bool correct = (prediction.prediction == taken);
+
+    if (every_arm_predicts()) {
+        typename MetaPredictorTelemetry<NUM_ARMS>::arm_correct_type arm_correct{};
+        for (std::size_t i = 0; i < NUM_ARMS; ++i)
+            arm_correct[i] = (prediction.arm_predictions[i] == taken);
+        telemetry_.record_all(slot, owner, prediction.chosen_arm, correct, arm_correct);
+        if (mode_ == meta_training_mode::oracle)
+            telemetry_.record_oracle(slot, owner, correct, arm_correct);
+    } else if (mode_ == meta_training_mode::gated) {
+        typename MetaPredictorTelemetry<NUM_ARMS>::arm_correct_type arm_correct{};
+        std::size_t evaluated = 0;
+        for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+            arm_correct[i] = (prediction.arm_predictions[i] == taken);
+            evaluated += (prediction.evaluated_arms >> i) & 1u;
+        }
+        const auto change = gates_.record(gated_slot(), prediction.evaluated_arms, arm_correct);
+        if (prediction.evaluated_arms == ArmGateTable<NUM_ARMS>::ALL_ARMS)
+            telemetry_.record_all(slot, owner, prediction.chosen_arm, correct, arm_correct);
+        else
+            telemetry_.record_chosen(slot, owner, prediction.chosen_arm, correct);
+        telemetry_.record_gating(evaluated, prediction.probe, change.gated, change.reopened);
+    } else {
+        telemetry_.record_chosen(slot, owner, prediction.chosen_arm, correct);
+    }
+
+    if constexpr (IS_VOTING) {
+        train_all(id, ip, branch_target, taken, branch_type, std::index_sequence_for<Arms...>{});
+        bandit_.update_votes(state, prediction.arm_predictions, taken);
+    } else if (every_arm_predicts()) {
+        train_all(id, ip, branch_target, taken, branch_type, std::index_sequence_for<Arms...>{});
+        for (std::size_t i = 0; i < NUM_ARMS; ++i)
+            bandit_.update(state, static_cast<int>(i), reward(prediction.arm_predictions[i] == taken, prediction.arm_confidences[i]));
+    } else if (mode_ == meta_training_mode::gated) {
+        train_active(prediction.evaluated_arms, id, ip, branch_target, taken, branch_type, std::index_sequence_for<Arms...>{});
+        for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+            if ((prediction.evaluated_arms >> i) & 1u)
+                bandit_.update(state, static_cast<int>(i), reward(prediction.arm_predictions[i] == taken, prediction.arm_confidences[i]));
+        }
+    } else {
+        train_arm(prediction.chosen_arm, id, ip, branch_target, taken, branch_type, std::index_sequence_for<Arms...>{});
+        bandit_.update(state, prediction.chosen_arm, reward(correct, prediction.arm_confidences[static_cast<std::size_t>(prediction.chosen_arm)]));
+    }
+}
+
+#endif // BASIC_META_PREDICTOR_H
@@ -0,0 +1,218 @@
+#ifndef FIXED_POINT_BANDIT_H
+#define FIXED_POINT_BANDIT_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "msl/xoshiro.h"
+
+/**
+ * Integer bandit engines for the meta predictors.
+ *
+ * Value estimates are kept in fixed point with VALUE_FRACTION_BITS fractional bits. The
+ * running mean is approximated with power-of-two step sizes, Q += (r - Q) >> lg2(n), so an
+ * update is a subtract, a shift and an add. Anything that needs exp, log or sqrt is read
+ * from a lookup table built once when the policy is constructed, so nothing on the
+ * per-branch path uses floating point.
+ */
+namespace fixed_point_bandit_detail {
+// Counts saturate at 2^16 - 1, so a step may be shifted down by up to 15 bits. A value keeps 9
+// fractional bits below that, or every mean collapses toward the few steps that still round to
+// a whole unit: with 16 bits, a mean of 0.55 and one of 0.9 both settle at 0.75.
+constexpr int VALUE_FRACTION_BITS = 24;
+
+// A single count-leading-zeros instead of the shift loop in champsim::msl::lg2(). x must be nonzero.
+inline unsigned floor_log2(uint32_t x) { return 31u - static_cast<unsigned>(__builtin_clz(x)); }
+
+// Quantize a count logarithmically: exact below 8, then eight buckets per power of two.
+constexpr std::size_t LOG_BUCKETS = 256;
+constexpr unsigned LOG_BUCKET_FRACTION_BITS = 3;
+
+inline std::size_t log_bucket(uint32_t x) {
+    if (x < (1u << LOG_BUCKET_FRACTION_BITS))
+        return x;
+    auto lg = floor_log2(x);
+    auto fraction = (x >> (lg - LOG_BUCKET_FRACTION_BITS)) & ((1u << LOG_BUCKET_FRACTION_BITS) - 1);
+    return ((lg - LOG_BUCKET_FRACTION_BITS + 1) << LOG_BUCKET_FRACTION_BITS) + fraction;
+}
+
+// The midpoint of the counts that fall in a bucket, used to fill the lookup tables
+inline double log_bucket_midpoint(std::size_t bucket) {
+    if (bucket < (1u << LOG_BUCKET_FRACTION_BITS))
+        return static_cast<double>(bucket);
+    auto lg = (bucket >> LOG_BUCKET_FRACTION_BITS) + LOG_BUCKET_FRACTION_BITS - 1;
+    auto fraction = bucket & ((1u << LOG_BUCKET_FRACTION_BITS) - 1);
+    auto width = std::ldexp(1.0, static_cast<int>(lg - LOG_BUCKET_FRACTION_BITS));
+    auto offset = (width > 1.0) ? 0.5 * width : 0.0;
+    return std::ldexp(1.0, static_cast<int>(lg)) + static_cast<double>(fraction) * width + offset;
+}
+
+// Power-of-two approximation of the 1/n running-mean step. The step is rounded to nearest rather
+// than floored, since flooring biases every step down by half a unit and the value would drift
+// once steps become small.
+inline int32_t step_toward(int32_t value, int32_t target, uint32_t count) {
+    auto shift = floor_log2(count);
+    auto rounding = (shift > 0) ? (int32_t{1} << (shift - 1)) : 0;
+    return value + ((target - value + rounding) >> shift);
+}
+
+template <typename T>
+void saturating_increment(T& counter) {
+    if (counter != std::numeric_limits<T>::max())
+        ++counter;
+}
+
+// The UCB exploration bonus sqrt(2 log(total) / count) in value fixed point. It is split as
+// sqrt(2 log(total)) * (1/sqrt(count)), each tabulated over log-quantized counts. Counts may
+// carry count_fraction_bits fractional bits.
+class ucb_exploration_table {
+public:
+    explicit ucb_exploration_table(int count_fraction_bits = 0);
+
+    int64_t bonus(uint32_t total, uint32_t count) const {
+        return (static_cast<int64_t>(log_term_[log_bucket(total)]) * inv_sqrt_term_[log_bucket(count)]) >> INV_SQRT_FRACTION_BITS;
+    }
+
+private:
+    static constexpr int INV_SQRT_FRACTION_BITS = 16;
+    std::array<int32_t, LOG_BUCKETS> log_term_{};
+    std::array<int32_t, LOG_BUCKETS> inv_sqrt_term_{};
+};
+
+inline ucb_exploration_table::ucb_exploration_table(int count_fraction_bits) {
+    for (std::size_t i = 1; i < LOG_BUCKETS; ++i) {
+        auto count = std::ldexp(log_bucket_midpoint(i), -count_fraction_bits);
+        log_term_[i] = static_cast<int32_t>(std::lround(std::ldexp(std::sqrt(2.0 * std::max(std::log(count), 0.0)), VALUE_FRACTION_BITS)));
+        inv_sqrt_term_[i] = static_cast<int32_t>(std::lround(std::ldexp(1.0 / std::sqrt(count), INV_SQRT_FRACTION_BITS)));
+    }
+}
+} // namespace fixed_point_bandit_detail
+
+// --- Fixed-point Epsilon-Greedy Bandit policy ---
+template <std::size_t NUM_ARMS>
+class FixedPointEpsilonGreedyBandit {
+public:
+    using reward_type = int32_t;
+    static constexpr std::size_t SCHEDULE_LENGTH = 256;
+
+    struct state_type {
+        std::array<int32_t, NUM_ARMS> values{};
+        std::array<uint16_t, NUM_ARMS> counts{};
+        uint32_t total_updates = 0;
+    };
+
+    FixedPointEpsilonGreedyBandit(double initial_epsilon = 0.05, double decay_rate = 0.0001, uint64_t seed = 0);
+
+    static reward_type make_reward(double reward) {
+        return static_cast<reward_type>(std::lround(std::ldexp(reward, fixed_point_bandit_detail::VALUE_FRACTION_BITS)));
+    }
+
+    int select_arm(state_type& state);
+    void update(state_type& state, int arm, reward_type reward) const;
+    reward_type value(const state_type& state, int arm) const { return state.values[static_cast<std::size_t>(arm)]; }
+
+private:
+    champsim::msl::xoshiro256starstar rng_;
+
+    // Exploration probability in 1/65536ths, indexed by total_updates >> schedule_shift_
+    std::array<uint32_t, SCHEDULE_LENGTH> epsilon_schedule_{};
+    unsigned schedule_shift_ = 0;
+};
+
+// --- Fixed-point UCB1 Bandit policy ---
+template <std::size_t NUM_ARMS>
+class FixedPointUCB1Bandit {
+public:
+    using reward_type = int32_t;
+
+    struct state_type {
+        std::array<int32_t, NUM_ARMS> values{};
+        std::array<uint16_t, NUM_ARMS> counts{};
+        uint32_t total_pulls = 0;
+    };
+
+    static reward_type make_reward(double reward) { return FixedPointEpsilonGreedyBandit<NUM_ARMS>::make_reward(reward); }
+
+    int select_arm(state_type& state) const;
+    void update(state_type& state, int arm, reward_type reward) const;
+    reward_type value(const state_type& state, int arm) const { return state.values[static_cast<std::size_t>(arm)]; }
+
+private:
+    fixed_point_bandit_detail::ucb_exploration_table exploration_{};
+};
+
+// --- FixedPointEpsilonGreedyBandit Implementation ---
+
+template <std::size_t NUM_ARMS>
+FixedPointEpsilonGreedyBandit<NUM_ARMS>::FixedPointEpsilonGreedyBandit(double initial_epsilon, double decay_rate, uint64_t seed)
+    : rng_(seed) {
+    // Stretch the schedule so that it ends about where epsilon falls below one part in 65536
+    if (decay_rate > 0.0 && initial_epsilon > 0.0) {
+        auto horizon = std::log(initial_epsilon * 65536.0) / decay_rate;
+        while (schedule_shift_ < 31 && std::ldexp(static_cast<double>(SCHEDULE_LENGTH), static_cast<int>(schedule_shift_)) < horizon)
+            ++schedule_shift_;
+    } else {
+        schedule_shift_ = 31;
+    }
+
+    for (std::size_t i = 0; i < SCHEDULE_LENGTH; ++i) {
+        auto updates = std::ldexp(static_cast<double>(i), static_cast<int>(schedule_shift_));
+        auto epsilon = initial_epsilon * std::exp(-decay_rate * updates);
+        epsilon_schedule_[i] = static_cast<uint32_t>(std::lround(std::clamp(epsilon, 0.0, 1.0) * 65536.0));
+    }
+}
+
+template <std::size_t NUM_ARMS>
+int FixedPointEpsilonGreedyBandit<NUM_ARMS>::select_arm(state_type& state) {
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        if (state.counts[i] == 0)
+            return static_cast<int>(i);
+    }
+
+    auto step = std::min<std::size_t>(state.total_updates >> schedule_shift_, SCHEDULE_LENGTH - 1);
+    // One draw gives both the exploration coin (high 16 bits) and the random arm (low 32 bits)
+    const auto draw = rng_();
+    if ((draw >> 48) < epsilon_schedule_[step]) {
+        return static_cast<int>((draw & 0xffffffff) % NUM_ARMS);
+    }
+
+    auto best = std::max_element(std::begin(state.values), std::end(state.values));
+    return static_cast<int>(std::distance(std::begin(state.values), best));
+}
+
+template <std::size_t NUM_ARMS>
+void FixedPointEpsilonGreedyBandit<NUM_ARMS>::update(state_type& state, int arm, reward_type reward) const {
+    fixed_point_bandit_detail::saturating_increment(state.counts[arm]);
+    fixed_point_bandit_detail::saturating_increment(state.total_updates);
+    state.values[arm] = fixed_point_bandit_detail::step_toward(state.values[arm], reward, state.counts[arm]);
+}
+
+// --- FixedPointUCB1Bandit Implementation ---
+
+template <std::size_t NUM_ARMS>
+int FixedPointUCB1Bandit<NUM_ARMS>::select_arm(state_type& state) const {
+    int best_arm = 0;
+    int64_t best_score = std::numeric_limits<int64_t>::min();
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        if (state.counts[i] == 0)
+            return static_cast<int>(i);
+        auto score = state.values[i] + exploration_.bonus(state.total_pulls, state.counts[i]);
+        if (score > best_score) {
+            best_score = score;
+            best_arm = static_cast<int>(i);
+        }
+    }
+    return best_arm;
+}
+
+template <std::size_t NUM_ARMS>
+void FixedPointUCB1Bandit<NUM_ARMS>::update(state_type& state, int arm, reward_type reward) const {
+    fixed_point_bandit_detail::saturating_increment(state.counts[arm]);
+    fixed_point_bandit_detail::saturating_increment(state.total_pulls);
+    state.values[arm] = fixed_point_bandit_detail::step_toward(state.values[arm], reward, state.counts[arm]);
+}
+
+#endif // FIXED_POINT_BANDIT_H
@@ -1,61 +1,118 @@
 #ifndef META_PREDICTOR_H
 #define META_PREDICTOR_H
 
+#include <array>
 #include <cstdint>
-#include <cstdlib>
-#include <vector>
-#include <unordered_map>
 #include <cmath>
 #include <numeric>
+#include <random>
 
 #include "../../inc/address.h"
 #include "modules.h"
+#include "msl/xoshiro.h"
 
 #include "../bimodal/bimodal.h"
 #include "../gshare/gshare.h"
 #include "../hashed_perceptron/hashed_perceptron.h"
 #include "../perceptron/perceptron.h"
+#include "../tage_sc_l/tage_sc_l.h"
+#include "bandit_table.h"
+#include "basic_meta_predictor.h"
+#include "fixed_point_bandit.h"
 
-// --- Epsilon-Greedy Bandit per bucket ---
+// --- Epsilon-Greedy Bandit policy ---
+// This is the floating-point reference. FixedPointEpsilonGreedyBandit is the integer engine.
+template <std::size_t NUM_ARMS>
 class EpsilonGreedyBandit {
 public:
-    EpsilonGreedyBandit(int num_arms, double initial_epsilon = 0.05, double decay_rate = 0.0001);
+    using reward_type = double;
 
-    int select_arm();
-    void update(int arm, double reward);
-    void step(); // decay epsilon
+    struct state_type {
+        std::array<int, NUM_ARMS> counts{};
+        std::array<double, NUM_ARMS> values{};
+        double epsilon = 0.0;
+        size_t total_updates = 0;
+    };
+
+    EpsilonGreedyBandit(double initial_epsilon = 0.05, double decay_rate = 0.0001, uint64_t seed = 0);
+
+    static reward_type make_reward(double reward) { return reward; }
+
+    int select_arm(state_type& state);
+    void update(state_type& state, int arm, reward_type reward) const;
+    reward_type value(const state_type& state, int arm) const { return state.values[static_cast<std::size_t>(arm)]; }
 
 private:
-    int num_arms_;
     double initial_epsilon_;
     double decay_rate_;
-    double epsilon_;
-    size_t total_updates_;
+    champsim::msl::xoshiro256starstar rng_;
+};
+
+// The bandit engine used by meta_predictor. Either epsilon-greedy engine may be selected here.
+using meta_predictor_bandit = FixedPointEpsilonGreedyBandit<5>;
 
-    std::vector<int> counts_;
-    std::vector<double> values_;
+// The parameters of meta_predictor that can be chosen when it is constructed, such as by the sweep engine
+struct meta_predictor_parameters {
+    double initial_epsilon = 0.05;
+    double decay_rate = 0.0001;
+    double reward_correct = 1.0;
+    double reward_incorrect = -0.5;
+    std::size_t bandit_set_bits = 10;
+    bool confidence_rewards = false;   // scale each reward by the arm's confidence in its prediction
+    bool confidence_selection = false; // prefer the most confident of the arms with close values, in the shadow and oracle modes
 };
 
-class meta_predictor {
+class meta_predictor
+    : public basic_meta_predictor<meta_predictor_bandit, perceptron, bimodal, gshare, hashed_perceptron, tage_sc_l> {
 public:
+    static constexpr std::size_t BANDIT_SETS = 1024;
+    static constexpr std::size_t BANDIT_WAYS = 4;
+    static constexpr std::size_t BANDIT_TAG_BITS = 12;
+    static constexpr meta_training_mode TRAINING_MODE = meta_training_mode::chosen_arm;
+
     meta_predictor(double initial_epsilon = 0.05, double decay_rate = 0.0001);
     meta_predictor(O3_CPU* cpu, double initial_epsilon = 0.05, double decay_rate = 0.0001);
+    meta_predictor(O3_CPU* cpu, const meta_predictor_parameters& parameters);
+};
 
-    bool predict_branch(champsim::address ip);
-    void last_branch_result(champsim::address ip,
-                            champsim::address branch_target,
-                            bool taken,
-                            uint8_t branch_type);
+// --- EpsilonGreedyBandit Implementation ---
 
-private:
-    std::vector<champsim::modules::branch_predictor*> arms_;
-    std::unordered_map<size_t, EpsilonGreedyBandit> bandit_buckets_;
+template <std::size_t NUM_ARMS>
+EpsilonGreedyBandit<NUM_ARMS>::EpsilonGreedyBandit(double initial_epsilon, double decay_rate, uint64_t seed)
+    : initial_epsilon_(initial_epsilon),
+      decay_rate_(decay_rate),
+      rng_(seed) {}
 
-    int last_chosen_arm_;
-    bool last_prediction_;
+template <std::size_t NUM_ARMS>
+int EpsilonGreedyBandit<NUM_ARMS>::select_arm(state_type& state) {
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        if (state.counts[i] == 0)
+            return static_cast<int>(i);
+    }
+    double r = std::uniform_real_distribution<double>{}(rng_);
+    if (r < state.epsilon) {
+        return std::uniform_int_distribution<int>{0, static_cast<int>(NUM_ARMS) - 1}(rng_);
+    }
+    double best_value = -1e9;
+    int best_arm = 0;
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        if (state.values[i] > best_value) {
+            best_value = state.values[i];
+            best_arm = static_cast<int>(i);
+        }
+    }
+    return best_arm;
+}
 
-    double initial_epsilon_;
-    double decay_rate_;
-};
+template <std::size_t NUM_ARMS>
+void EpsilonGreedyBandit<NUM_ARMS>::update(state_type& state, int arm, reward_type reward) const {
+    state.counts[arm] += 1;
+    state.total_updates++;
+    double n = state.counts[arm];
+    state.values[arm] = ((n - 1) / n) * state.values[arm] + (reward / n);
+
+    // decay epsilon
+    state.epsilon = initial_epsilon_ * exp(-decay_rate_ * static_cast<double>(state.total_updates));
+}
 
-#endif // META_PREDICTOR_H
\ No newline at end of file
+#endif // META_PREDICTOR_H
@@ -0,0 +1,253 @@
+#ifndef META_PREDICTOR_TELEMETRY_H
+#define META_PREDICTOR_TELEMETRY_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "core_stats.h"
+
+/**
+ * Counters describing how a meta predictor chooses between its arms.
+ *
+ * Every counter is a plain integer in an array owned by the predictor, and they are only
+ * written when a branch resolves, never when it is predicted. Per-bucket counters are kept in
+ * a flat array indexed by the bandit table slot, next to (not inside) the bandit state. When a
+ * slot is reallocated to another branch, the counters for its old bucket are folded into the
+ * totals and the slot starts again.
+ *
+ * The regret of a bucket is how many more branches its best arm would have predicted correctly
+ * than the meta predictor did. It can only be measured on branches where every arm predicted,
+ * which is every branch in shadow mode or for a voting policy, and none otherwise.
+ *
+ * A bucket has converged once it has chosen the same arm for CONVERGENCE_RUN branches in a row,
+ * and its convergence time is the number of branches it saw before that run began. Only the
+ * first convergence of each bucket is counted, and voting policies, which choose no arm, are
+ * not tracked.
+ *
+ * In the oracle training mode, each branch is also measured against two choosers that cannot
+ * be built: the per-branch oracle, which is correct whenever any arm is, and the best fixed arm
+ * for each bucket over the phase.
+ *
+ * The regret and the best fixed arm are maxima over the phase, so they cannot be found as the
+ * difference of two reports. Instead begin_phase() clears the per-bucket counts they are taken
+ * from, and they are reported for the phase so far, at zero at the start of the phase.
+ *
+ * In the gated training mode, the arms evaluated on each branch are counted, with the probes
+ * and how many times an arm was gated in, or reopened for, a bucket.
+ */
+template <std::size_t NUM_ARMS>
+class MetaPredictorTelemetry {
+public:
+    static constexpr uint32_t CONVERGENCE_RUN = 64;
+
+    using arm_correct_type = std::array<bool, NUM_ARMS>;
+
+    explicit MetaPredictorTelemetry(std::size_t num_buckets);
+
+    // A branch resolved in a bucket where only the chosen arm predicted
+    void record_chosen(std::size_t bucket, uint64_t owner, int arm, bool correct);
+
+    // A branch resolved in a bucket where every arm predicted. For a voting policy, arm is -1
+    // and every arm that agreed with the vote is counted as selected.
+    void record_all(std::size_t bucket, uint64_t owner, int arm, bool correct, const arm_correct_type& arm_correct);
+
+    // A branch resolved in the oracle training mode, after it was recorded with record_all()
+    void record_oracle(std::size_t bucket, uint64_t owner, bool correct, const arm_correct_type& arm_correct);
+
+    // A branch resolved in the gated training mode, where evaluated arms predicted, and gated arms were gated and reopened arms reopened
+    void record_gating(std::size_t evaluated, bool probe, std::size_t gated, std::size_t reopened);
+
+    // Start measuring the regret and the best fixed arms again
+    void begin_phase();
+
+    meta_predictor_stats stats() const;
+
+private:
+    struct bucket_type {
+        uint64_t owner = 0;
+        std::array<uint32_t, NUM_ARMS> arm_correct{};
+        std::array<uint32_t, NUM_ARMS> oracle_arm_correct{}; // the same, over the branches in the oracle training mode
+        uint32_t correct = 0;
+        uint32_t evaluated = 0; // branches on which every arm predicted
+        uint32_t branches = 0;
+        uint32_t run_length = 0;
+        int run_arm = -1;
+        bool converged = false;
+
+        int64_t regret() const;
+        uint64_t static_best() const;
+        void clear_phase();
+    };
+
+    std::array<uint64_t, NUM_ARMS> selections_{};
+    std::array<uint64_t, NUM_ARMS> correct_{};
+    std::array<uint64_t, NUM_ARMS> incorrect_{};
+    std::array<uint64_t, meta_predictor_stats::CONVERGENCE_BINS> convergence_times_{};
+
+    // Totals for buckets whose slot has since been reallocated, in this phase
+    int64_t retired_regret_ = 0;
+    uint64_t retired_evaluated_ = 0;
+    uint64_t retired_static_best_ = 0;
+
+    std::vector<bucket_type> buckets_;
+
+    uint64_t oracle_branches_ = 0;
+    uint64_t chooser_correct_ = 0;
+    uint64_t oracle_correct_ = 0;
+
+    uint64_t gated_branches_ = 0;
+    uint64_t gated_evaluations_ = 0;
+    uint64_t gate_probes_ = 0;
+    uint64_t arms_gated_ = 0;
+    uint64_t arms_reopened_ = 0;
+
+    bucket_type& claim(std::size_t bucket, uint64_t owner);
+    void record_arm(bucket_type& entry, int arm);
+};
+
+// --- MetaPredictorTelemetry Implementation ---
+
+template <std::size_t NUM_ARMS>
+MetaPredictorTelemetry<NUM_ARMS>::MetaPredictorTelemetry(std::size_t num_buckets)
+    : buckets_(num_buckets) {}
+
+template <std::size_t NUM_ARMS>
+int64_t MetaPredictorTelemetry<NUM_ARMS>::bucket_type::regret() const {
+    return static_cast<int64_t>(*std::max_element(std::begin(arm_correct), std::end(arm_correct))) - correct;
+}
+
+template <std::size_t NUM_ARMS>
+uint64_t MetaPredictorTelemetry<NUM_ARMS>::bucket_type::static_best() const {
+    return *std::max_element(std::begin(oracle_arm_correct), std::end(oracle_arm_correct));
+}
+
+template <std::size_t NUM_ARMS>
+void MetaPredictorTelemetry<NUM_ARMS>::bucket_type::clear_phase() {
+    arm_correct = {};
+    oracle_arm_correct = {};
+    correct = 0;
+    evaluated = 0;
+}
+
+template <std::size_t NUM_ARMS>
+auto MetaPredictorTelemetry<NUM_ARMS>::claim(std::size_t bucket, uint64_t owner) -> bucket_type& {
+    auto& entry = buckets_[bucket];
+    if (entry.owner != owner) {
+        retired_regret_ += entry.regret();
+        retired_evaluated_ += entry.evaluated;
+        retired_static_best_ += entry.static_best();
+        entry = bucket_type{};
+        entry.owner = owner;
+    }
+    return entry;
+}
+
+template <std::size_t NUM_ARMS>
+void MetaPredictorTelemetry<NUM_ARMS>::record_arm(bucket_type& entry, int arm) {
+    ++selections_[static_cast<std::size_t>(arm)];
+    ++entry.branches;
+    if (entry.converged)
+        return;
+
+    entry.run_length = (arm == entry.run_arm) ? entry.run_length + 1 : 1;
+    entry.run_arm = arm;
+    if (entry.run_length == CONVERGENCE_RUN) {
+        entry.converged = true;
+        auto time = entry.branches - CONVERGENCE_RUN;
+        std::size_t bin = 0;
+        while (time > 0 && bin < meta_predictor_stats::CONVERGENCE_BINS - 1) {
+            time >>= 1;
+            ++bin;
+        }
+        ++convergence_times_[bin];
+    }
+}
+
+template <std::size_t NUM_ARMS>
+void MetaPredictorTelemetry<NUM_ARMS>::record_chosen(std::size_t bucket, uint64_t owner, int arm, bool correct) {
+    auto& entry = claim(bucket, owner);
+    record_arm(entry, arm);
+    ++(correct ? correct_ : incorrect_)[static_cast<std::size_t>(arm)];
+}
+
+template <std::size_t NUM_ARMS>
+void MetaPredictorTelemetry<NUM_ARMS>::record_all(std::size_t bucket, uint64_t owner, int arm, bool correct, const arm_correct_type& arm_correct) {
+    auto& entry = claim(bucket, owner);
+    if (arm >= 0) {
+        record_arm(entry, arm);
+    } else {
+        for (std::size_t i = 0; i < NUM_ARMS; ++i)
+            selections_[i] += (arm_correct[i] == correct);
+    }
+
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        ++(arm_correct[i] ? correct_ : incorrect_)[i];
+        entry.arm_correct[i] += arm_correct[i];
+    }
+    entry.correct += correct;
+    ++entry.evaluated;
+}
+
+template <std::size_t NUM_ARMS>
+void MetaPredictorTelemetry<NUM_ARMS>::record_oracle(std::size_t bucket, uint64_t owner, bool correct, const arm_correct_type& arm_correct) {
+    ++oracle_branches_;
+    chooser_correct_ += correct;
+    oracle_correct_ += std::any_of(std::begin(arm_correct), std::end(arm_correct), [](bool arm) { return arm; });
+
+    auto& entry = claim(bucket, owner);
+    for (std::size_t i = 0; i < NUM_ARMS; ++i)
+        entry.oracle_arm_correct[i] += arm_correct[i];
+}
+
+template <std::size_t NUM_ARMS>
+void MetaPredictorTelemetry<NUM_ARMS>::record_gating(std::size_t evaluated, bool probe, std::size_t gated, std::size_t reopened) {
+    ++gated_branches_;
+    gated_evaluations_ += evaluated;
+    gate_probes_ += probe;
+    arms_gated_ += gated;
+    arms_reopened_ += reopened;
+}
+
+template <std::size_t NUM_ARMS>
+void MetaPredictorTelemetry<NUM_ARMS>::begin_phase() {
+    retired_regret_ = 0;
+    retired_evaluated_ = 0;
+    retired_static_best_ = 0;
+    for (auto& entry : buckets_)
+        entry.clear_phase();
+}
+
+template <std::size_t NUM_ARMS>
+meta_predictor_stats MetaPredictorTelemetry<NUM_ARMS>::stats() const {
+    meta_predictor_stats result{};
+    result.arm_selections.assign(std::begin(selections_), std::end(selections_));
+    result.arm_correct.assign(std::begin(correct_), std::end(correct_));
+    result.arm_incorrect.assign(std::begin(incorrect_), std::end(incorrect_));
+    result.convergence_times = convergence_times_;
+
+    result.regret = retired_regret_;
+    result.regret_branches = retired_evaluated_;
+    result.static_best_correct = retired_static_best_;
+    for (const auto& entry : buckets_) {
+        result.regret += entry.regret();
+        result.regret_branches += entry.evaluated;
+        result.static_best_correct += entry.static_best();
+        if (entry.branches > 0 && !entry.converged)
+            ++result.unconverged;
+    }
+
+    result.oracle_branches = oracle_branches_;
+    result.chooser_correct = chooser_correct_;
+    result.oracle_correct = oracle_correct_;
+
+    result.gated_branches = gated_branches_;
+    result.gated_evaluations = gated_evaluations_;
+    result.gate_probes = gate_probes_;
+    result.arms_gated = arms_gated_;
+    result.arms_reopened = arms_reopened_;
+    return result;
+}
+
+#endif // META_PREDICTOR_TELEMETRY_H
@@ -0,0 +1,189 @@
+#ifndef MULTIPLICATIVE_WEIGHTS_H
+#define MULTIPLICATIVE_WEIGHTS_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "msl/xoshiro.h"
+
+/**
+ * Multiplicative-weights policies for the meta predictors.
+ *
+ * Each bucket keeps one weight per arm as an integer base-2 logarithm with LOG_FRACTION_BITS
+ * fractional bits. A multiplicative update is then an add, and weights are turned back into
+ * linear values with a small table. After every update the weights are shifted so that the
+ * largest is 2^0, and none is allowed below 2^-MAX_LOG_BITS, which keeps them in range and lets
+ * an arm that was poor in an earlier phase regain its weight.
+ */
+namespace multiplicative_weights_detail {
+constexpr int LOG_FRACTION_BITS = 6;
+constexpr int MAX_LOG_BITS = 8;
+constexpr int16_t LOG_FLOOR = -(MAX_LOG_BITS << LOG_FRACTION_BITS);
+constexpr int WEIGHT_FRACTION_BITS = 15;
+constexpr int REWARD_FRACTION_BITS = 8;
+
+// 2^(-i / 2^LOG_FRACTION_BITS) for each representable log weight, with WEIGHT_FRACTION_BITS fractional bits
+class weight_table {
+public:
+    weight_table() {
+        for (std::size_t i = 0; i < weights_.size(); ++i) {
+            auto log_weight = -std::ldexp(static_cast<double>(i), -LOG_FRACTION_BITS);
+            weights_[i] = static_cast<int32_t>(std::lround(std::ldexp(std::exp2(log_weight), WEIGHT_FRACTION_BITS)));
+        }
+    }
+
+    int32_t operator[](int16_t log_weight) const { return weights_[static_cast<std::size_t>(-log_weight)]; }
+
+private:
+    std::array<int32_t, static_cast<std::size_t>(-LOG_FLOOR) + 1> weights_{};
+};
+
+// Convert a learning rate in natural-log units to log-weight units
+inline int16_t log_step(double learning_rate) {
+    return static_cast<int16_t>(std::max(1l, std::lround(std::ldexp(learning_rate / std::log(2.0), LOG_FRACTION_BITS))));
+}
+
+template <std::size_t NUM_ARMS>
+void renormalize(std::array<int16_t, NUM_ARMS>& log_weights) {
+    auto top = *std::max_element(std::begin(log_weights), std::end(log_weights));
+    for (auto& log_weight : log_weights)
+        log_weight = static_cast<int16_t>(std::max<int>(log_weight - top, LOG_FLOOR));
+}
+} // namespace multiplicative_weights_detail
+
+// --- Hedge voting policy ---
+// Full-information multiplicative weights. The prediction is the weighted vote of every arm,
+// and every arm that was wrong has its weight multiplied by exp(-learning_rate).
+template <std::size_t NUM_ARMS>
+class HedgeVote {
+public:
+    using reward_type = int32_t;
+
+    struct state_type {
+        std::array<int16_t, NUM_ARMS> log_weights{};
+    };
+
+    explicit HedgeVote(double learning_rate = 0.25);
+
+    // Rewards are in Q.8 fixed point. The vote is trained on the arms' outcomes, not on rewards.
+    static reward_type make_reward(double reward) {
+        return static_cast<reward_type>(std::lround(std::ldexp(reward, multiplicative_weights_detail::REWARD_FRACTION_BITS)));
+    }
+
+    bool vote(state_type& state, const std::array<bool, NUM_ARMS>& predictions) const;
+    void update_votes(state_type& state, const std::array<bool, NUM_ARMS>& predictions, bool taken) const;
+
+private:
+    int16_t penalty_;
+    multiplicative_weights_detail::weight_table weights_{};
+};
+
+// --- EXP3 Bandit policy ---
+// Multiplicative weights with partial feedback: one arm is drawn from the mixture of the
+// weights and the uniform distribution, and only that arm's loss is seen. The loss of a reward r
+// is 1 - r, so a reward of 1 costs nothing and a lower reward costs in proportion; it is divided
+// by the probability the arm had of being drawn, so that the update is unbiased.
+template <std::size_t NUM_ARMS>
+class EXP3Bandit {
+public:
+    using reward_type = int32_t;
+    static constexpr int PROBABILITY_BITS = 16;
+
+    struct state_type {
+        std::array<int16_t, NUM_ARMS> log_weights{};
+    };
+
+    explicit EXP3Bandit(double learning_rate = 0.05, double exploration = 0.05, uint64_t seed = 0);
+
+    static reward_type make_reward(double reward) { return HedgeVote<NUM_ARMS>::make_reward(reward); }
+
+    int select_arm(state_type& state);
+    void update(state_type& state, int arm, reward_type reward) const;
+
+private:
+    int16_t penalty_;
+    uint32_t exploration_; // in 1/2^PROBABILITY_BITS
+    champsim::msl::xoshiro256starstar rng_;
+    multiplicative_weights_detail::weight_table weights_{};
+
+    int64_t weight_sum(const state_type& state) const;
+};
+
+// --- HedgeVote Implementation ---
+
+template <std::size_t NUM_ARMS>
+HedgeVote<NUM_ARMS>::HedgeVote(double learning_rate)
+    : penalty_(multiplicative_weights_detail::log_step(learning_rate)) {}
+
+template <std::size_t NUM_ARMS>
+bool HedgeVote<NUM_ARMS>::vote(state_type& state, const std::array<bool, NUM_ARMS>& predictions) const {
+    int64_t total = 0;
+    for (std::size_t i = 0; i < NUM_ARMS; ++i)
+        total += predictions[i] ? weights_[state.log_weights[i]] : -weights_[state.log_weights[i]];
+    return total >= 0;
+}
+
+template <std::size_t NUM_ARMS>
+void HedgeVote<NUM_ARMS>::update_votes(state_type& state, const std::array<bool, NUM_ARMS>& predictions, bool taken) const {
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        if (predictions[i] != taken)
+            state.log_weights[i] = static_cast<int16_t>(state.log_weights[i] - penalty_);
+    }
+    multiplicative_weights_detail::renormalize(state.log_weights);
+}
+
+// --- EXP3Bandit Implementation ---
+
+template <std::size_t NUM_ARMS>
+EXP3Bandit<NUM_ARMS>::EXP3Bandit(double learning_rate, double exploration, uint64_t seed)
+    : penalty_(multiplicative_weights_detail::log_step(learning_rate)),
+      exploration_(static_cast<uint32_t>(std::lround(std::ldexp(std::clamp(exploration, 0.0, 1.0), PROBABILITY_BITS)))),
+      rng_(seed) {}
+
+template <std::size_t NUM_ARMS>
+int64_t EXP3Bandit<NUM_ARMS>::weight_sum(const state_type& state) const {
+    int64_t total = 0;
+    for (auto log_weight : state.log_weights)
+        total += weights_[log_weight];
+    return total;
+}
+
+template <std::size_t NUM_ARMS>
+int EXP3Bandit<NUM_ARMS>::select_arm(state_type& state) {
+    // The high 16 bits decide whether to explore, and the low 48 bits pick the arm
+    const auto draw = rng_();
+    const auto pick = draw & ((uint64_t{1} << 48) - 1);
+    if ((draw >> 48) < exploration_)
+        return static_cast<int>(pick % NUM_ARMS);
+
+    auto target = static_cast<int64_t>(pick % static_cast<uint64_t>(weight_sum(state)));
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        target -= weights_[state.log_weights[i]];
+        if (target < 0)
+            return static_cast<int>(i);
+    }
+    return static_cast<int>(NUM_ARMS - 1);
+}
+
+template <std::size_t NUM_ARMS>
+void EXP3Bandit<NUM_ARMS>::update(state_type& state, int arm, reward_type reward) const {
+    using namespace multiplicative_weights_detail;
+    const int64_t loss = (int64_t{1} << REWARD_FRACTION_BITS) - reward;
+    if (loss <= 0)
+        return;
+
+    // p = (1 - gamma) w / W + gamma / K, and the penalty is scaled by loss / p, rounded to nearest
+    const int64_t total = weight_sum(state);
+    const int64_t weight = weights_[state.log_weights[arm]];
+    const int64_t scaled_probability =
+        (((int64_t{1} << PROBABILITY_BITS) - exploration_) * weight + (exploration_ * total) / static_cast<int64_t>(NUM_ARMS)) << REWARD_FRACTION_BITS;
+    const int64_t step = std::min<int64_t>(((penalty_ * loss * total << PROBABILITY_BITS) + scaled_probability / 2) / scaled_probability, -LOG_FLOOR);
+
+    state.log_weights[arm] = static_cast<int16_t>(state.log_weights[arm] - step);
+    multiplicative_weights_detail::renormalize(state.log_weights);
+}
+
+#endif // MULTIPLICATIVE_WEIGHTS_H
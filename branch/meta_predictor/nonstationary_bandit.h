@@ -0,0 +1,177 @@
+#ifndef NONSTATIONARY_BANDIT_H
+#define NONSTATIONARY_BANDIT_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "fixed_point_bandit.h"
+
+/**
+ * UCB engines for arms whose value changes over time.
+ *
+ * UCB1 averages every reward an arm has ever received, so after a phase change a bucket
+ * keeps choosing the arm that used to be best until the new rewards outweigh the old. These
+ * engines only remember recent history: the discounted engine decays every count and value
+ * geometrically, and the sliding-window engine forgets anything older than its last WINDOW
+ * updates. Both have the same surface as FixedPointUCB1Bandit and use the same fixed point.
+ */
+
+// --- Fixed-point Discounted UCB Bandit policy ---
+// Every update scales all arms' counts by the discount, so a count is the discounted number of
+// recent pulls and is bounded by 1/(1 - discount). The value of an arm is the discounted mean
+// of its rewards, which does not change while the arm is not pulled. The counts keep enough
+// fractional bits, and each scaling is rounded to nearest, so that a pull fades by the discount
+// each update rather than by a fixed step.
+template <std::size_t NUM_ARMS>
+class FixedPointDiscountedUCBBandit {
+public:
+    using reward_type = int32_t;
+    static constexpr int COUNT_FRACTION_BITS = 16;
+    static constexpr int DISCOUNT_FRACTION_BITS = 32;
+
+    struct state_type {
+        std::array<int32_t, NUM_ARMS> values{};
+        std::array<uint32_t, NUM_ARMS> counts{}; // discounted, with COUNT_FRACTION_BITS fractional bits
+    };
+
+    explicit FixedPointDiscountedUCBBandit(double discount = 0.999);
+
+    static reward_type make_reward(double reward) { return FixedPointEpsilonGreedyBandit<NUM_ARMS>::make_reward(reward); }
+
+    int select_arm(state_type& state) const;
+    void update(state_type& state, int arm, reward_type reward) const;
+    reward_type value(const state_type& state, int arm) const { return state.values[static_cast<std::size_t>(arm)]; }
+
+private:
+    uint64_t discount_;
+    fixed_point_bandit_detail::ucb_exploration_table exploration_{COUNT_FRACTION_BITS};
+};
+
+// --- Fixed-point Sliding-Window UCB Bandit policy ---
+// Each bucket keeps its last WINDOW (arm, reward) pairs in a ring, with running per-arm counts
+// and reward sums over the ring. Rewards are stored in the ring with STORED_FRACTION_BITS
+// fractional bits, so the state is about 3 * WINDOW bytes per bucket.
+template <std::size_t NUM_ARMS, std::size_t WINDOW = 256>
+class FixedPointSlidingWindowUCBBandit {
+public:
+    static_assert(NUM_ARMS <= std::numeric_limits<uint8_t>::max());
+    static_assert(WINDOW > 0 && WINDOW <= std::numeric_limits<uint16_t>::max());
+
+    using reward_type = int32_t;
+    static constexpr int STORED_FRACTION_BITS = 8;
+
+    struct state_type {
+        std::array<int32_t, NUM_ARMS> reward_sums{}; // with STORED_FRACTION_BITS fractional bits
+        std::array<uint16_t, NUM_ARMS> counts{};
+        std::array<uint8_t, WINDOW> arms{};
+        std::array<int16_t, WINDOW> rewards{};
+        uint16_t head = 0;
+        uint16_t filled = 0;
+    };
+
+    static reward_type make_reward(double reward) { return FixedPointEpsilonGreedyBandit<NUM_ARMS>::make_reward(reward); }
+
+    int select_arm(state_type& state) const;
+    void update(state_type& state, int arm, reward_type reward) const;
+
+    // The mean of the arm's rewards in the window, or 0 if it has none there
+    reward_type value(const state_type& state, int arm) const;
+
+private:
+    static constexpr int STORED_SHIFT = fixed_point_bandit_detail::VALUE_FRACTION_BITS - STORED_FRACTION_BITS;
+    fixed_point_bandit_detail::ucb_exploration_table exploration_{};
+};
+
+// --- FixedPointDiscountedUCBBandit Implementation ---
+
+template <std::size_t NUM_ARMS>
+FixedPointDiscountedUCBBandit<NUM_ARMS>::FixedPointDiscountedUCBBandit(double discount)
+    : discount_(static_cast<uint64_t>(std::lround(std::ldexp(std::clamp(discount, 0.0, 1.0), DISCOUNT_FRACTION_BITS))))
+{
+}
+
+template <std::size_t NUM_ARMS>
+int FixedPointDiscountedUCBBandit<NUM_ARMS>::select_arm(state_type& state) const {
+    uint32_t total = 0;
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        // An arm that was never pulled is tried first. Rounding keeps a decayed count above zero,
+        // so an arm that has not been pulled for a long time gets a large bonus instead
+        if (state.counts[i] == 0)
+            return static_cast<int>(i);
+        total += state.counts[i];
+    }
+
+    int best_arm = 0;
+    int64_t best_score = std::numeric_limits<int64_t>::min();
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        auto score = state.values[i] + exploration_.bonus(total, state.counts[i]);
+        if (score > best_score) {
+            best_score = score;
+            best_arm = static_cast<int>(i);
+        }
+    }
+    return best_arm;
+}
+
+template <std::size_t NUM_ARMS>
+void FixedPointDiscountedUCBBandit<NUM_ARMS>::update(state_type& state, int arm, reward_type reward) const {
+    for (auto& count : state.counts)
+        count = static_cast<uint32_t>((count * discount_ + (uint64_t{1} << (DISCOUNT_FRACTION_BITS - 1))) >> DISCOUNT_FRACTION_BITS);
+
+    // The counts only come near the limit for a discount within 2^-16 of 1
+    constexpr uint32_t pull = 1u << COUNT_FRACTION_BITS;
+    auto& count = state.counts[static_cast<std::size_t>(arm)];
+    count = (count > std::numeric_limits<uint32_t>::max() - pull) ? std::numeric_limits<uint32_t>::max() : count + pull;
+
+    // The discounted mean moves by (r - Q) / N, with N the discounted count including this pull
+    state.values[arm] = fixed_point_bandit_detail::step_toward(state.values[arm], reward, state.counts[arm] >> COUNT_FRACTION_BITS);
+}
+
+// --- FixedPointSlidingWindowUCBBandit Implementation ---
+
+template <std::size_t NUM_ARMS, std::size_t WINDOW>
+int FixedPointSlidingWindowUCBBandit<NUM_ARMS, WINDOW>::select_arm(state_type& state) const {
+    int best_arm = 0;
+    int64_t best_score = std::numeric_limits<int64_t>::min();
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        if (state.counts[i] == 0)
+            return static_cast<int>(i);
+        auto score = value(state, static_cast<int>(i)) + exploration_.bonus(state.filled, state.counts[i]);
+        if (score > best_score) {
+            best_score = score;
+            best_arm = static_cast<int>(i);
+        }
+    }
+    return best_arm;
+}
+
+template <std::size_t NUM_ARMS, std::size_t WINDOW>
+auto FixedPointSlidingWindowUCBBandit<NUM_ARMS, WINDOW>::value(const state_type& state, int arm) const -> reward_type {
+    const auto i = static_cast<std::size_t>(arm);
+    if (state.counts[i] == 0)
+        return 0;
+    return static_cast<reward_type>((static_cast<int64_t>(state.reward_sums[i]) << STORED_SHIFT) / state.counts[i]);
+}
+
+template <std::size_t NUM_ARMS, std::size_t WINDOW>
+void FixedPointSlidingWindowUCBBandit<NUM_ARMS, WINDOW>::update(state_type& state, int arm, reward_type reward) const {
+    if (state.filled == WINDOW) {
+        auto oldest = state.arms[state.head];
+        --state.counts[oldest];
+        state.reward_sums[oldest] -= state.rewards[state.head];
+    } else {
+        ++state.filled;
+    }
+
+    auto stored = static_cast<int16_t>(reward >> STORED_SHIFT);
+    state.arms[state.head] = static_cast<uint8_t>(arm);
+    state.rewards[state.head] = stored;
+    ++state.counts[arm];
+    state.reward_sums[arm] += stored;
+    state.head = static_cast<uint16_t>((state.head + 1) % WINDOW);
+}
+
+#endif // NONSTATIONARY_BANDIT_H
@@ -0,0 +1,54 @@
+#ifndef STORAGE_BUDGET_H
+#define STORAGE_BUDGET_H
+
+#include <cstddef>
+
+#include "modules.h"
+
+#include "bandit_table.h"
+
+/**
+ * Chooses, at compile time, the size at which a meta predictor fits in a storage budget.
+ *
+ * Every arm and the bandit table are resized by the same factor of 2^LOG_SCALE, the largest
+ * for which their total storage is within the budget. A meta predictor built this way can be
+ * compared fairly with a single predictor of the same size.
+ *
+ * \tparam BUDGET_BITS The storage budget, in bits.
+ * \tparam BanditState The state of each bandit table entry.
+ * \tparam BANDIT_SETS The number of bandit table sets at the default size.
+ * \tparam BANDIT_WAYS The number of bandit table ways, which is not scaled.
+ * \tparam BANDIT_TAG_BITS The width of the bandit table tags.
+ * \tparam Arms The templates of the arms. Each takes a log2 scale factor, and reports its
+ * storage with a static constexpr storage_bits().
+ */
+template <std::size_t BUDGET_BITS, typename BanditState, std::size_t BANDIT_SETS, std::size_t BANDIT_WAYS, std::size_t BANDIT_TAG_BITS,
+          template <int> class... Arms>
+struct storage_budget {
+    template <int SCALE>
+    static constexpr std::size_t bandit_sets = champsim::modules::branch_predictor::scale_size(BANDIT_SETS, SCALE);
+
+    template <int SCALE>
+    static constexpr std::size_t total_bits =
+        (Arms<SCALE>::storage_bits() + ... + (bandit_sets<SCALE> * BANDIT_WAYS * BanditTable<BanditState>::entry_bits(BANDIT_WAYS, BANDIT_TAG_BITS)));
+
+    template <int SCALE>
+    static constexpr int largest_fit() {
+        if constexpr (SCALE == champsim::modules::branch_predictor::MIN_LOG_SCALE || total_bits<SCALE> <= BUDGET_BITS)
+            return SCALE;
+        else
+            return largest_fit<SCALE - 1>();
+    }
+
+    static constexpr int LOG_SCALE = largest_fit<champsim::modules::branch_predictor::MAX_LOG_SCALE>();
+    static_assert(total_bits<LOG_SCALE> <= BUDGET_BITS, "The budget is too small for the arms at their smallest size");
+
+    // An arm, and the geometry of the bandit table, at the chosen scale
+    template <template <int> class Arm>
+    using arm = Arm<LOG_SCALE>;
+    static constexpr std::size_t bandit_table_sets = bandit_sets<LOG_SCALE>;
+    static constexpr std::size_t bandit_table_ways = BANDIT_WAYS;
+    static constexpr std::size_t bandit_table_tag_bits = BANDIT_TAG_BITS;
+};
+
+#endif
@@ -0,0 +1,9 @@
+#include "meta_predictor_budget.h"
+
+// --- meta_predictor_budget Implementation ---
+
+meta_predictor_budget::meta_predictor_budget()
+    : meta_predictor_budget(nullptr) {}
+
+meta_predictor_budget::meta_predictor_budget(O3_CPU* cpu)
+    : basic_meta_predictor(cpu, BANDIT_SETS, BANDIT_WAYS, BANDIT_TAG_BITS, meta_predictor_budget_bandit{}, TRAINING_MODE) {}
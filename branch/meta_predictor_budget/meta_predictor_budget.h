@@ -0,0 +1,45 @@
+#ifndef META_PREDICTOR_BUDGET_H
+#define META_PREDICTOR_BUDGET_H
+
+#include <cstddef>
+
+#include "modules.h"
+
+#include "../bimodal/bimodal.h"
+#include "../gshare/gshare.h"
+#include "../hashed_perceptron/hashed_perceptron.h"
+#include "../perceptron/perceptron.h"
+#include "../tage_sc_l/tage_sc_l.h"
+#include "../meta_predictor/basic_meta_predictor.h"
+#include "../meta_predictor/fixed_point_bandit.h"
+#include "../meta_predictor/storage_budget.h"
+
+// The bandit engine used by meta_predictor_budget
+using meta_predictor_budget_bandit = FixedPointUCB1Bandit<5>;
+
+// The arms and bandit table of meta_predictor_budget are scaled to fit in this many bits. The
+// bandit table has 1024 sets of 4 ways with 12-bit tags before it is scaled.
+constexpr std::size_t META_PREDICTOR_BUDGET_BITS = 64 * 1024 * 8;
+
+using meta_predictor_budget_size = storage_budget<META_PREDICTOR_BUDGET_BITS, meta_predictor_budget_bandit::state_type, 1024, 4, 12, basic_perceptron,
+                                                  basic_bimodal, basic_gshare, basic_hashed_perceptron, basic_tage_sc_l>;
+
+/**
+ * The arms of meta_predictor_ucb, with the arms and bandit table scaled to fit in a storage budget,
+ * for a fair comparison with a single predictor of that size.
+ */
+class meta_predictor_budget
+    : public basic_meta_predictor<meta_predictor_budget_bandit, meta_predictor_budget_size::arm<basic_perceptron>, meta_predictor_budget_size::arm<basic_bimodal>,
+                                  meta_predictor_budget_size::arm<basic_gshare>, meta_predictor_budget_size::arm<basic_hashed_perceptron>,
+                                  meta_predictor_budget_size::arm<basic_tage_sc_l>> {
+public:
+    static constexpr std::size_t BANDIT_SETS = meta_predictor_budget_size::bandit_table_sets;
+    static constexpr std::size_t BANDIT_WAYS = meta_predictor_budget_size::bandit_table_ways;
+    static constexpr std::size_t BANDIT_TAG_BITS = meta_predictor_budget_size::bandit_table_tag_bits;
+    static constexpr meta_training_mode TRAINING_MODE = meta_training_mode::chosen_arm;
+
+    meta_predictor_budget();
+    meta_predictor_budget(O3_CPU* cpu);
+};
+
+#endif
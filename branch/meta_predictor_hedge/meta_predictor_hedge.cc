@@ -0,0 +1,9 @@
+#include "meta_predictor_hedge.h"
+
+// --- meta_predictor_hedge Implementation ---
+
+meta_predictor_hedge::meta_predictor_hedge()
+    : meta_predictor_hedge(nullptr) {}
+
+meta_predictor_hedge::meta_predictor_hedge(O3_CPU* cpu)
+    : basic_meta_predictor(cpu, BANDIT_SETS, BANDIT_WAYS, BANDIT_TAG_BITS, meta_predictor_hedge_policy{LEARNING_RATE}, TRAINING_MODE) {}
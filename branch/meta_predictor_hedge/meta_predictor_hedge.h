@@ -0,0 +1,34 @@
+#ifndef META_PREDICTOR_HEDGE_H
+#define META_PREDICTOR_HEDGE_H
+
+#include <cstdint>
+
+#include "../../inc/address.h"
+#include "modules.h"
+
+#include "../bimodal/bimodal.h"
+#include "../gshare/gshare.h"
+#include "../hashed_perceptron/hashed_perceptron.h"
+#include "../perceptron/perceptron.h"
+#include "../meta_predictor/bandit_table.h"
+#include "../meta_predictor/basic_meta_predictor.h"
+#include "../meta_predictor/multiplicative_weights.h"
+
+// The policy used by meta_predictor_hedge. HedgeVote combines every arm's vote; EXP3Bandit<4>
+// may be selected here instead to choose one arm per branch from partial feedback.
+using meta_predictor_hedge_policy = HedgeVote<4>;
+
+class meta_predictor_hedge
+    : public basic_meta_predictor<meta_predictor_hedge_policy, perceptron, bimodal, gshare, hashed_perceptron> {
+public:
+    static constexpr std::size_t BANDIT_SETS = 1024;
+    static constexpr std::size_t BANDIT_WAYS = 4;
+    static constexpr std::size_t BANDIT_TAG_BITS = 12;
+    static constexpr meta_training_mode TRAINING_MODE = meta_training_mode::chosen_arm;
+    static constexpr double LEARNING_RATE = 0.25;
+
+    meta_predictor_hedge();
+    meta_predictor_hedge(O3_CPU* cpu);
+};
+
+#endif // META_PREDICTOR_HEDGE_H
@@ -0,0 +1,59 @@
+#include "meta_predictor_linucb.h"
+
+#include <cassert>
+
+#include "instruction.h"
+
+// --- meta_predictor_linucb Implementation ---
+
+meta_predictor_linucb::meta_predictor_linucb()
+    : meta_predictor_linucb(nullptr) {}
+
+meta_predictor_linucb::meta_predictor_linucb(O3_CPU* cpu)
+    : basic_meta_predictor(cpu, BANDIT_SETS, BANDIT_WAYS, BANDIT_TAG_BITS, meta_predictor_linucb_bandit{ALPHA}, TRAINING_MODE) {}
+
+meta_predictor_linucb_bandit::context_type meta_predictor_linucb::make_context(uint8_t branch_type) const {
+    auto feature = [](bool set) { return static_cast<int8_t>(set ? 1 : -1); };
+
+    meta_predictor_linucb_bandit::context_type context{};
+    auto it = std::begin(context);
+    *it++ = 1;
+
+    auto history = global_history_.value();
+    for (std::size_t i = 0; i < LINUCB_HISTORY_FEATURES; ++i)
+        *it++ = feature(((history >> i) & 1) != 0);
+
+    *it++ = feature(branch_type == BRANCH_CONDITIONAL);
+
+    it = std::transform(std::cbegin(arm_correct_), std::cend(arm_correct_), it, feature);
+    assert(it == std::end(context));
+    return context;
+}
+
+bool meta_predictor_linucb::predict_branch(prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken,
+                                          uint8_t branch_type) {
+    const auto context = make_context(branch_type);
+    contexts_.push(id, context);
+    bandit_.set_context(context);
+    return basic_meta_predictor::predict_branch(id, ip, predicted_target, always_taken, branch_type);
+}
+
+void meta_predictor_linucb::last_branch_result(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken,
+                                               uint8_t branch_type) {
+    const auto* context = contexts_.find(id);
+    const auto* found = in_flight_.find(id);
+    if (context != nullptr && found != nullptr) {
+        const auto prediction = *found;
+        bandit_.set_context(*context);
+        basic_meta_predictor::last_branch_result(id, ip, branch_target, taken, branch_type);
+
+        for (std::size_t i = 0; i < LINUCB_ARMS; ++i) {
+            if ((prediction.evaluated_arms >> i) & 1u)
+                arm_correct_[i] = (prediction.arm_predictions[i] == taken);
+        }
+    }
+    contexts_.erase(id);
+
+    if (branch_type == BRANCH_CONDITIONAL)
+        global_history_.push_back(taken);
+}
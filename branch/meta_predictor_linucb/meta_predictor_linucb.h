@@ -0,0 +1,243 @@
+#ifndef META_PREDICTOR_LINUCB_H
+#define META_PREDICTOR_LINUCB_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "../../inc/address.h"
+#include "modules.h"
+
+#include "../bimodal/bimodal.h"
+#include "../gshare/gshare.h"
+#include "../hashed_perceptron/folded_shift_register.h"
+#include "../hashed_perceptron/hashed_perceptron.h"
+#include "../perceptron/perceptron.h"
+#include "../meta_predictor/bandit_table.h"
+#include "../meta_predictor/basic_meta_predictor.h"
+
+// --- LinUCB Bandit policy ---
+// A contextual bandit with a disjoint linear model per arm. The expected reward of an arm is
+// theta . x for the context x, with theta = A^-1 b fitted by ridge regression, and the arm with
+// the largest theta . x + alpha * sqrt(x . A^-1 x) is selected.
+//
+// A^-1 is kept directly and updated with the Sherman-Morrison formula, so an update is a
+// matrix-vector product and a rank-one correction on a DIMENSIONS x DIMENSIONS matrix held in
+// place, with no allocation or inversion. A^-1 is symmetric, so only its upper triangle is
+// kept, in INVERSE_FRACTION_BITS fixed point. Rather than b, each arm keeps theta in
+// THETA_FRACTION_BITS fixed point and moves it by the same update as recursive least squares,
+// theta += (A^-1 x) (r - theta . x) after A^-1 has taken x in. Every feature is +1 or -1, so the
+// products with x are additions, and the square root is taken on integers, so nothing on the
+// per-branch path uses floating point.
+//
+// The context is shared by every bucket and is set by the predictor before each selection.
+template <std::size_t NUM_ARMS, std::size_t DIMENSIONS>
+class LinUCBBandit {
+public:
+    using reward_type = int32_t;
+    using context_type = std::array<int8_t, DIMENSIONS>; // each feature is +1 or -1
+    static constexpr int THETA_FRACTION_BITS = 12;
+    static constexpr int INVERSE_FRACTION_BITS = 24;
+    static constexpr std::size_t TRIANGLE_SIZE = DIMENSIONS * (DIMENSIONS + 1) / 2;
+
+    using matrix_type = std::array<int32_t, TRIANGLE_SIZE>; // the upper triangle of A^-1, row by row
+
+    struct state_type {
+        std::array<matrix_type, NUM_ARMS> a_inverse = identities(); // the starting model is A = I, theta = 0
+        std::array<std::array<int16_t, DIMENSIONS>, NUM_ARMS> theta{};
+    };
+
+    explicit LinUCBBandit(double alpha = 0.5);
+
+    // Rewards are clamped to what a weight can hold, [-8, 8)
+    static reward_type make_reward(double reward) {
+        const auto fixed = std::lround(std::ldexp(reward, THETA_FRACTION_BITS));
+        return static_cast<reward_type>(std::clamp<long>(fixed, std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max()));
+    }
+
+    void set_context(const context_type& context) { context_ = context; }
+    const context_type& context() const { return context_; }
+
+    int select_arm(state_type& state) const;
+    void update(state_type& state, int arm, reward_type reward) const;
+
+    // The expected reward of the arm in the current context, theta . x
+    reward_type value(const state_type& state, int arm) const;
+
+private:
+    context_type context_{};
+    int32_t alpha_; // in THETA_FRACTION_BITS fixed point
+
+    static constexpr std::size_t entry(std::size_t row, std::size_t col) {
+        return (row <= col) ? row * DIMENSIONS - row * (row - 1) / 2 + (col - row) : entry(col, row);
+    }
+    static constexpr std::array<matrix_type, NUM_ARMS> identities();
+
+    // u = A^-1 x, in INVERSE_FRACTION_BITS fixed point
+    std::array<int64_t, DIMENSIONS> project(const matrix_type& a_inverse) const;
+
+    // x . u, which is never negative in exact arithmetic
+    int64_t variance(const std::array<int64_t, DIMENSIONS>& u) const;
+
+    static uint32_t isqrt(uint64_t x);
+};
+
+// The bandit engine used by meta_predictor_linucb
+constexpr std::size_t LINUCB_ARMS = 4;
+constexpr std::size_t LINUCB_HISTORY_FEATURES = 4;
+constexpr std::size_t LINUCB_DIMENSIONS = 1 + LINUCB_HISTORY_FEATURES + 1 + LINUCB_ARMS;
+using meta_predictor_linucb_bandit = LinUCBBandit<LINUCB_ARMS, LINUCB_DIMENSIONS>;
+
+/**
+ * A meta predictor that chooses its arm with LinUCB.
+ *
+ * The context for each branch is, in order: a bias term, the global history folded down to
+ * LINUCB_HISTORY_FEATURES bits, whether the branch is conditional, and whether each arm was
+ * correct the last time its outcome was seen. Every feature is +1 or -1. Only the chosen arm's
+ * outcome is seen in the chosen_arm training mode, and only the active arms' in the gated mode;
+ * every arm's is seen in the shadow and oracle modes.
+ *
+ * Each bucket holds the upper triangle of A^-1 in 32-bit entries and DIMENSIONS 16-bit weights
+ * per arm, 960 bytes with the defaults. The table has an eighth of the sets of the other meta
+ * predictors to stay under 512 KB.
+ */
+class meta_predictor_linucb
+    : public basic_meta_predictor<meta_predictor_linucb_bandit, perceptron, bimodal, gshare, hashed_perceptron> {
+public:
+    static constexpr std::size_t BANDIT_SETS = 128;
+    static constexpr std::size_t BANDIT_WAYS = 4;
+    static constexpr std::size_t BANDIT_TAG_BITS = 12;
+    static constexpr meta_training_mode TRAINING_MODE = meta_training_mode::chosen_arm;
+    static constexpr double ALPHA = 0.1;
+    static constexpr champsim::data::bits HISTORY_LENGTH{32};
+
+    meta_predictor_linucb();
+    meta_predictor_linucb(O3_CPU* cpu);
+
+    bool predict_branch(prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type);
+    void last_branch_result(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+
+    // Without identifiers, each branch is resolved before the next is predicted
+    bool predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) {
+        return predict_branch(in_flight_.last() + 1, ip, predicted_target, always_taken, branch_type);
+    }
+    void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type) {
+        last_branch_result(in_flight_.last(), ip, branch_target, taken, branch_type);
+    }
+
+private:
+    folded_shift_register<champsim::data::bits{LINUCB_HISTORY_FEATURES}> global_history_{HISTORY_LENGTH};
+    std::array<bool, LINUCB_ARMS> arm_correct_{};
+
+    // The context of each prediction, which the bandit is trained with when the branch is resolved
+    champsim::msl::sequence_ring<meta_predictor_linucb_bandit::context_type, NUM_IN_FLIGHT> contexts_;
+
+    meta_predictor_linucb_bandit::context_type make_context(uint8_t branch_type) const;
+};
+
+// --- LinUCBBandit Implementation ---
+
+template <std::size_t NUM_ARMS, std::size_t DIMENSIONS>
+LinUCBBandit<NUM_ARMS, DIMENSIONS>::LinUCBBandit(double alpha)
+    : alpha_(static_cast<int32_t>(std::lround(std::ldexp(alpha, THETA_FRACTION_BITS)))) {}
+
+template <std::size_t NUM_ARMS, std::size_t DIMENSIONS>
+constexpr auto LinUCBBandit<NUM_ARMS, DIMENSIONS>::identities() -> std::array<matrix_type, NUM_ARMS> {
+    std::array<matrix_type, NUM_ARMS> result{};
+    for (auto& matrix : result) {
+        for (std::size_t i = 0; i < DIMENSIONS; ++i)
+            matrix[entry(i, i)] = int32_t{1} << INVERSE_FRACTION_BITS;
+    }
+    return result;
+}
+
+template <std::size_t NUM_ARMS, std::size_t DIMENSIONS>
+auto LinUCBBandit<NUM_ARMS, DIMENSIONS>::project(const matrix_type& a_inverse) const -> std::array<int64_t, DIMENSIONS> {
+    std::array<int64_t, DIMENSIONS> u{};
+    for (std::size_t row = 0; row < DIMENSIONS; ++row) {
+        for (std::size_t col = 0; col < DIMENSIONS; ++col)
+            u[row] += (context_[col] < 0) ? -a_inverse[entry(row, col)] : a_inverse[entry(row, col)];
+    }
+    return u;
+}
+
+template <std::size_t NUM_ARMS, std::size_t DIMENSIONS>
+int64_t LinUCBBandit<NUM_ARMS, DIMENSIONS>::variance(const std::array<int64_t, DIMENSIONS>& u) const {
+    int64_t result = 0;
+    for (std::size_t i = 0; i < DIMENSIONS; ++i)
+        result += (context_[i] < 0) ? -u[i] : u[i];
+
+    // Rounding can leave the variance slightly negative once it is very small
+    return std::max<int64_t>(result, 0);
+}
+
+template <std::size_t NUM_ARMS, std::size_t DIMENSIONS>
+uint32_t LinUCBBandit<NUM_ARMS, DIMENSIONS>::isqrt(uint64_t x) {
+    uint64_t result = 0;
+    for (uint64_t bit = uint64_t{1} << 62; bit != 0; bit >>= 2) {
+        if (x >= result + bit) {
+            x -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+    }
+    return static_cast<uint32_t>(result);
+}
+
+template <std::size_t NUM_ARMS, std::size_t DIMENSIONS>
+auto LinUCBBandit<NUM_ARMS, DIMENSIONS>::value(const state_type& state, int arm) const -> reward_type {
+    const auto& theta = state.theta[static_cast<std::size_t>(arm)];
+    reward_type mean = 0;
+    for (std::size_t i = 0; i < DIMENSIONS; ++i)
+        mean += (context_[i] < 0) ? -theta[i] : theta[i];
+    return mean;
+}
+
+template <std::size_t NUM_ARMS, std::size_t DIMENSIONS>
+int LinUCBBandit<NUM_ARMS, DIMENSIONS>::select_arm(state_type& state) const {
+    static_assert(INVERSE_FRACTION_BITS == 2 * THETA_FRACTION_BITS, "The square root of the variance must be in the fixed point of theta");
+
+    int best_arm = 0;
+    int64_t best_score = std::numeric_limits<int64_t>::min();
+    for (std::size_t arm = 0; arm < NUM_ARMS; ++arm) {
+        const auto deviation = isqrt(static_cast<uint64_t>(variance(project(state.a_inverse[arm]))));
+        const auto score = value(state, static_cast<int>(arm)) + ((int64_t{alpha_} * deviation) >> THETA_FRACTION_BITS);
+        if (score > best_score) {
+            best_score = score;
+            best_arm = static_cast<int>(arm);
+        }
+    }
+    return best_arm;
+}
+
+template <std::size_t NUM_ARMS, std::size_t DIMENSIONS>
+void LinUCBBandit<NUM_ARMS, DIMENSIONS>::update(state_type& state, int arm, reward_type reward) const {
+    const auto index = static_cast<std::size_t>(arm);
+    auto& a_inverse = state.a_inverse[index];
+    auto& theta = state.theta[index];
+
+    const auto u = project(a_inverse);
+    const auto denominator = (int64_t{1} << INVERSE_FRACTION_BITS) + variance(u);
+    auto divide = [denominator](int64_t numerator) {
+        const auto half = denominator / 2;
+        return (numerator >= 0) ? (numerator + half) / denominator : -((-numerator + half) / denominator);
+    };
+
+    // (A + x x^T)^-1 = A^-1 - (A^-1 x)(A^-1 x)^T / (1 + x^T A^-1 x)
+    for (std::size_t row = 0; row < DIMENSIONS; ++row) {
+        for (std::size_t col = row; col < DIMENSIONS; ++col)
+            a_inverse[entry(row, col)] -= static_cast<int32_t>(divide(u[row] * u[col]));
+    }
+
+    // The new A^-1 x is u / (1 + x^T A^-1 x), so theta moves by that times the error of its prediction
+    const int64_t error = reward - value(state, arm);
+    for (std::size_t i = 0; i < DIMENSIONS; ++i) {
+        const auto moved = theta[i] + divide(u[i] * error);
+        theta[i] = static_cast<int16_t>(std::clamp<int64_t>(moved, std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max()));
+    }
+}
+
+#endif // META_PREDICTOR_LINUCB_H
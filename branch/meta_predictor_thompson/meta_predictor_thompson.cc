@@ -0,0 +1,9 @@
+#include "meta_predictor_thompson.h"
+
+// --- meta_predictor_thompson Implementation ---
+
+meta_predictor_thompson::meta_predictor_thompson()
+    : meta_predictor_thompson(nullptr) {}
+
+meta_predictor_thompson::meta_predictor_thompson(O3_CPU* cpu)
+    : basic_meta_predictor(cpu, BANDIT_SETS, BANDIT_WAYS, BANDIT_TAG_BITS, meta_predictor_thompson_bandit{SEED}, TRAINING_MODE) {}
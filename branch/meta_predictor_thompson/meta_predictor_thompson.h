@@ -0,0 +1,129 @@
+#ifndef META_PREDICTOR_THOMPSON_H
+#define META_PREDICTOR_THOMPSON_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "../../inc/address.h"
+#include "modules.h"
+#include "msl/xoshiro.h"
+
+#include "../bimodal/bimodal.h"
+#include "../gshare/gshare.h"
+#include "../hashed_perceptron/hashed_perceptron.h"
+#include "../perceptron/perceptron.h"
+#include "../meta_predictor/bandit_table.h"
+#include "../meta_predictor/basic_meta_predictor.h"
+#include "../meta_predictor/fixed_point_bandit.h"
+
+// --- Thompson Sampling Bandit policy ---
+// Beta-Bernoulli Thompson sampling: a positive reward counts as a success for the arm, any
+// other reward as a failure. Each arm keeps a Beta(successes + 1, failures + 1) posterior,
+// and the arm with the largest sample from its posterior is selected.
+//
+// The Beta samples are approximated by a normal with the same mean and variance. The
+// standard deviation is read from two tables, sqrt(p(1-p)) over the quantized mean and
+// 1/sqrt(n+1) over the log-quantized count, and the normal deviate is the sum of four
+// uniform 16-bit draws taken from a single 64-bit output of the generator.
+template <std::size_t NUM_ARMS>
+class ThompsonSamplingBandit {
+public:
+    using reward_type = int32_t;
+    static constexpr int PROBABILITY_BITS = 16;
+
+    struct state_type {
+        std::array<uint16_t, NUM_ARMS> successes{};
+        std::array<uint16_t, NUM_ARMS> failures{};
+    };
+
+    explicit ThompsonSamplingBandit(uint64_t seed = 0);
+
+    static reward_type make_reward(double reward) { return FixedPointEpsilonGreedyBandit<NUM_ARMS>::make_reward(reward); }
+
+    int select_arm(state_type& state);
+    void update(state_type& state, int arm, reward_type reward) const;
+
+private:
+    static constexpr int SPREAD_INDEX_BITS = 6;
+
+    champsim::msl::xoshiro256starstar rng_;
+    std::array<int32_t, (1u << SPREAD_INDEX_BITS) + 1> spread_{};
+    std::array<int32_t, fixed_point_bandit_detail::LOG_BUCKETS> inv_sqrt_term_{};
+
+    int32_t sample(uint32_t alpha, uint32_t beta);
+};
+
+// The bandit engine used by meta_predictor_thompson
+using meta_predictor_thompson_bandit = ThompsonSamplingBandit<4>;
+
+class meta_predictor_thompson
+    : public basic_meta_predictor<meta_predictor_thompson_bandit, perceptron, bimodal, gshare, hashed_perceptron> {
+public:
+    static constexpr std::size_t BANDIT_SETS = 1024;
+    static constexpr std::size_t BANDIT_WAYS = 4;
+    static constexpr std::size_t BANDIT_TAG_BITS = 12;
+    static constexpr meta_training_mode TRAINING_MODE = meta_training_mode::chosen_arm;
+    static constexpr uint64_t SEED = 0;
+
+    meta_predictor_thompson();
+    meta_predictor_thompson(O3_CPU* cpu);
+};
+
+// --- ThompsonSamplingBandit Implementation ---
+
+template <std::size_t NUM_ARMS>
+ThompsonSamplingBandit<NUM_ARMS>::ThompsonSamplingBandit(uint64_t seed)
+    : rng_(seed) {
+    using namespace fixed_point_bandit_detail;
+    for (std::size_t i = 0; i < spread_.size(); ++i) {
+        auto p = std::ldexp(static_cast<double>(i), -SPREAD_INDEX_BITS);
+        spread_[i] = static_cast<int32_t>(std::lround(std::ldexp(std::sqrt(p * (1.0 - p)), PROBABILITY_BITS)));
+    }
+    for (std::size_t i = 1; i < LOG_BUCKETS; ++i)
+        inv_sqrt_term_[i] = static_cast<int32_t>(std::lround(std::ldexp(1.0 / std::sqrt(log_bucket_midpoint(i)), PROBABILITY_BITS)));
+}
+
+template <std::size_t NUM_ARMS>
+int32_t ThompsonSamplingBandit<NUM_ARMS>::sample(uint32_t alpha, uint32_t beta) {
+    using namespace fixed_point_bandit_detail;
+    const uint32_t n = alpha + beta;
+    const int64_t mean = (static_cast<int64_t>(alpha) << PROBABILITY_BITS) / n;
+    const int64_t spread = spread_[static_cast<std::size_t>(mean >> (PROBABILITY_BITS - SPREAD_INDEX_BITS))];
+    const int64_t deviation = (spread * inv_sqrt_term_[log_bucket(n + 1)]) >> PROBABILITY_BITS;
+
+    // The sum of four uniforms has mean 2 * 65535 and standard deviation 65536 / sqrt(3)
+    const auto draw = rng_();
+    const int64_t sum = static_cast<int64_t>((draw & 0xffff) + ((draw >> 16) & 0xffff) + ((draw >> 32) & 0xffff) + (draw >> 48));
+    const int64_t normal = ((sum - 2 * 0xffff) * 113512) >> PROBABILITY_BITS; // 113512 ~ sqrt(3) * 65536
+
+    return static_cast<int32_t>(mean + ((deviation * normal) >> PROBABILITY_BITS));
+}
+
+template <std::size_t NUM_ARMS>
+int ThompsonSamplingBandit<NUM_ARMS>::select_arm(state_type& state) {
+    int best_arm = 0;
+    int32_t best_sample = std::numeric_limits<int32_t>::min();
+    for (std::size_t i = 0; i < NUM_ARMS; ++i) {
+        auto value = sample(state.successes[i] + 1u, state.failures[i] + 1u);
+        if (value > best_sample) {
+            best_sample = value;
+            best_arm = static_cast<int>(i);
+        }
+    }
+    return best_arm;
+}
+
+template <std::size_t NUM_ARMS>
+void ThompsonSamplingBandit<NUM_ARMS>::update(state_type& state, int arm, reward_type reward) const {
+    auto& counter = (reward > 0) ? state.successes[arm] : state.failures[arm];
+    // Halve both counts rather than saturate, which keeps the ratio and lets the posterior keep moving
+    if (counter == std::numeric_limits<uint16_t>::max()) {
+        state.successes[arm] >>= 1;
+        state.failures[arm] >>= 1;
+    }
+    ++counter;
+}
+
+#endif // META_PREDICTOR_THOMPSON_H
@@ -1,10 +1,10 @@
 #ifndef META_PREDICTOR_UCB_H
 #define META_PREDICTOR_UCB_H
 
+#include <array>
 #include <cstdint>
 #include <cstdlib>
-#include <vector>
-#include <unordered_map>
+#include <limits>
 #include <cmath>
 #include <numeric>
 
@@ -15,41 +15,82 @@
 #include "../gshare/gshare.h"
 #include "../hashed_perceptron/hashed_perceptron.h"
 #include "../perceptron/perceptron.h"
+#include "../tage_sc_l/tage_sc_l.h"
+#include "../meta_predictor/bandit_table.h"
+#include "../meta_predictor/basic_meta_predictor.h"
+#include "../meta_predictor/fixed_point_bandit.h"
+#include "../meta_predictor/nonstationary_bandit.h"
 
-// --- UCB1 Bandit per bucket ---
+// --- UCB1 Bandit policy ---
+// This is the floating-point reference. FixedPointUCB1Bandit is the integer engine.
+template <std::size_t NUM_ARMS>
 class UCB1Bandit {
 public:
-    UCB1Bandit(int num_arms);
+    using reward_type = double;
 
-    int select_arm();
-    void update(int arm, double reward);
+    struct state_type {
+        std::array<int, NUM_ARMS> counts{};
+        std::array<double, NUM_ARMS> values{};
+        int total_pulls = 0;
+    };
 
-private:
-    int num_arms_;
-    std::vector<int> counts_;
-    std::vector<double> values_;
-    int total_pulls_;
+    static reward_type make_reward(double reward) { return reward; }
+
+    int select_arm(state_type& state) const;
+    void update(state_type& state, int arm, reward_type reward) const;
+    reward_type value(const state_type& state, int arm) const { return state.values[static_cast<std::size_t>(arm)]; }
 
-    double ucb_score(int arm) const;
+private:
+    double ucb_score(const state_type& state, int arm) const;
 };
 
-class meta_predictor_ucb {
+// The bandit engine used by meta_predictor_ucb. Either UCB1 engine may be selected here, or, for
+// workloads with phase changes, FixedPointDiscountedUCBBandit or FixedPointSlidingWindowUCBBandit.
+using meta_predictor_ucb_bandit = FixedPointUCB1Bandit<5>;
+
+class meta_predictor_ucb
+    : public basic_meta_predictor<meta_predictor_ucb_bandit, perceptron, bimodal, gshare, hashed_perceptron, tage_sc_l> {
 public:
+    static constexpr std::size_t BANDIT_SETS = 1024;
+    static constexpr std::size_t BANDIT_WAYS = 4;
+    static constexpr std::size_t BANDIT_TAG_BITS = 12;
+    static constexpr meta_training_mode TRAINING_MODE = meta_training_mode::chosen_arm;
+
     meta_predictor_ucb();
     meta_predictor_ucb(O3_CPU* cpu);
+};
 
-    bool predict_branch(champsim::address ip);
-    void last_branch_result(champsim::address ip,
-                            champsim::address branch_target,
-                            bool taken,
-                            uint8_t branch_type);
+// --- UCB1Bandit Implementation ---
 
-private:
-    std::vector<champsim::modules::branch_predictor*> arms_;
-    std::unordered_map<size_t, UCB1Bandit> bandit_buckets_;
+template <std::size_t NUM_ARMS>
+double UCB1Bandit<NUM_ARMS>::ucb_score(const state_type& state, int arm) const {
+    if (state.counts[arm] == 0)
+        return std::numeric_limits<double>::max();
+    double exploitation = state.values[arm];
+    double exploration = std::sqrt(2.0 * std::log(static_cast<double>(state.total_pulls)) / state.counts[arm]);
+    return exploitation + exploration;
+}
 
-    int last_chosen_arm_;
-    bool last_prediction_;
-};
+template <std::size_t NUM_ARMS>
+int UCB1Bandit<NUM_ARMS>::select_arm(state_type& state) const {
+    double best_score = -std::numeric_limits<double>::max();
+    int best_arm = 0;
+    for (int i = 0; i < static_cast<int>(NUM_ARMS); ++i) {
+        double score = ucb_score(state, i);
+        if (score > best_score) {
+            best_score = score;
+            best_arm = i;
+        }
+    }
+    return best_arm;
+}
+
+template <std::size_t NUM_ARMS>
+void UCB1Bandit<NUM_ARMS>::update(state_type& state, int arm, reward_type reward) const {
+    state.counts[arm]++;
+    state.total_pulls++;
+    double n = static_cast<double>(state.counts[arm]);
+    state.values[arm] = ((n - 1.0) / n) * state.values[arm] + (reward / n);
+}
 
-#endif // META_PREDICTOR_UCB_H
\ No newline at end of file
+#endif // META_PREDICTOR_UCB_H
@@ -38,51 +38,71 @@
 
 #include "perceptron.h"
 
-#include <cmath>
-
-bool perceptron::predict_branch(champsim::address ip)
+template <int LOG_SCALE>
+bool basic_perceptron<LOG_SCALE>::predict_branch(prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken,
+                                                 uint8_t branch_type)
 {
   // hash the address to get an index into the table of perceptrons
   const auto index = ip.to<uint64_t>() % NUM_PERCEPTRONS;
-  const auto output = perceptrons[index].predict(spec_global_history);
+  const auto history = history_type::recent(global_history);
+  const auto output = perceptrons[index].predict(history);
+  last_output = output;
 
   bool prediction = (output >= 0);
 
   // record the various values needed to update the predictor
-  perceptron_state_buf.push_back({ip, prediction, output, spec_global_history});
-  if (std::size(perceptron_state_buf) > NUM_UPDATE_ENTRIES)
-    perceptron_state_buf.pop_front();
+  perceptron_state state{ip, prediction, output, history};
+
+  // update the speculative global history, which is repaired if this branch was mispredicted
+  if (branch_type != NOT_BRANCH) {
+    state.checkpoint = global_history.speculate(prediction || always_taken);
+    state.in_history = true;
+  }
 
-  // update the speculative global history register
-  spec_global_history <<= 1;
-  spec_global_history.set(0, prediction);
+  perceptron_state_buf.push(id, state);
   return prediction;
 }
 
-void perceptron::last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type)
+template <int LOG_SCALE>
+void basic_perceptron<LOG_SCALE>::repair_branch_history(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken,
+                                                        uint8_t branch_type)
 {
-  auto state = std::find_if(std::begin(perceptron_state_buf), std::end(perceptron_state_buf), [ip](auto x) { return x.ip == ip; });
-  if (state == std::end(perceptron_state_buf))
-    return; // Skip update because state was lost
+  auto* state = perceptron_state_buf.find(id);
+  if (state != nullptr && state->in_history)
+    global_history.repair(state->checkpoint, taken);
+}
 
-  auto [_ip, prediction, output, history] = *state;
-  perceptron_state_buf.erase(state);
+template <int LOG_SCALE>
+void basic_perceptron<LOG_SCALE>::last_branch_result(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken,
+                                                     uint8_t branch_type)
+{
+  auto* state = perceptron_state_buf.find(id);
+  if (state == nullptr || state->ip != ip)
+    return; // Skip update because state was lost
 
-  // update the real global history shift register
-  global_history <<= 1;
-  global_history.set(0, taken);
+  // if this branch was mispredicted, and the history has not yet been repaired, roll it back to before this branch
+  if (state->in_history)
+    global_history.repair(state->checkpoint, taken);
+  else
+    global_history.push(taken);
 
-  // if this branch was mispredicted, restore the speculative history to the
-  // last known real history
-  if (prediction != taken)
-    spec_global_history = global_history;
+  auto [_ip, prediction, output, history, checkpoint, in_history] = *state;
+  perceptron_state_buf.erase(id);
 
   // if the output of the perceptron predictor is outside of the range
   // [-THETA,THETA] *and* the prediction was correct, then we don't need to
   // adjust the weights
-  const auto THETA = std::lround(1.93 * PERCEPTRON_HISTORY + 14); // threshold for training
   if ((output <= THETA && output >= -THETA) || (prediction != taken)) {
     const auto index = ip.to<uint64_t>() % NUM_PERCEPTRONS;
     perceptrons[index].update(taken, history);
   }
 }
+
+// every scale from branch_predictor::MIN_LOG_SCALE to MAX_LOG_SCALE
+template struct basic_perceptron<-4>;
+template struct basic_perceptron<-3>;
+template struct basic_perceptron<-2>;
+template struct basic_perceptron<-1>;
+template struct basic_perceptron<0>;
+template struct basic_perceptron<1>;
+template struct basic_perceptron<2>;
@@ -1,85 +1,140 @@
 #ifndef BRANCH_PERCEPTRON_H
 #define BRANCH_PERCEPTRON_H
 
+#include <algorithm>
 #include <array>
-#include <bitset>
-#include <deque>
 
+#include "instruction.h"
 #include "modules.h"
-#include "msl/fwcounter.h"
-
-struct perceptron : champsim::modules::branch_predictor {
+#include "msl/sequence_ring.h"
+#include "msl/speculative_history.h"
+#include "perceptron_kernel.h"
+
+/*
+ * A table of perceptrons indexed by the address, with the number of perceptrons scaled by 2^LOG_SCALE from the default. The
+ * perceptron module is the default size.
+ */
+template <int LOG_SCALE>
+struct basic_perceptron : champsim::modules::branch_predictor {
+  /*
+   * The weights are stored as contiguous int8 so that the output and training are vectorized, which keeps longer histories
+   * (64 to 256 bits) from slowing the simulation down in proportion. Each weight saturates as an sfwcounter<BITS> would.
+   */
   template <std::size_t HISTLEN, std::size_t BITS>
   class internal_perceptron
   {
-    using counter_type = champsim::msl::sfwcounter<BITS>;
+    static_assert(BITS >= 2 && BITS <= 8, "The weights must fit in int8");
+    static constexpr auto WEIGHT_MAX = static_cast<int8_t>((1 << (BITS - 1)) - 1);
+    static constexpr auto WEIGHT_MIN = static_cast<int8_t>(-(1 << (BITS - 1)));
 
-    counter_type bias{0};
-    std::array<counter_type, HISTLEN> weights = {};
+    int8_t bias = 0;
+    perceptron_kernel::weight_vector<HISTLEN> weights = {};
 
   public:
-    typename counter_type::value_type predict(std::bitset<HISTLEN> history);
+    using history_type = perceptron_kernel::history_register<HISTLEN>;
 
-    void update(bool result, std::bitset<HISTLEN> history);
+    long long predict(const history_type& history) const;
+
+    void update(bool result, const history_type& history);
   };
 
   static constexpr std::size_t PERCEPTRON_HISTORY = 24; // history length for the global history shift register
   static constexpr std::size_t PERCEPTRON_BITS = 8;     // number of bits per weight
-  static constexpr std::size_t NUM_PERCEPTRONS = 163;
+  static constexpr std::size_t NUM_PERCEPTRONS = scale_size(163, LOG_SCALE);
+  static constexpr long long THETA = static_cast<long long>(1.93 * PERCEPTRON_HISTORY + 14 + 0.5); // threshold for training, rounded
+
+  static constexpr std::size_t NUM_UPDATE_ENTRIES = MAX_PREDICTIONS_IN_FLIGHT; // size of buffer for keeping 'perceptron_state' for update
 
-  static constexpr std::size_t NUM_UPDATE_ENTRIES = 100; // size of buffer for keeping 'perceptron_state' for update
+  static constexpr std::size_t HISTORY_RING_BITS = 2048; // the history, and every branch that may be pushed into it before a repair
+  static_assert(HISTORY_RING_BITS >= PERCEPTRON_HISTORY + NUM_UPDATE_ENTRIES);
+
+  using perceptron_type = internal_perceptron<PERCEPTRON_HISTORY, PERCEPTRON_BITS>;
+  using history_type = typename perceptron_type::history_type;
+
+  // the global history, updated as branches are predicted, read a bit at a time so that it may be longer than a fold
+  using speculative_history_type = champsim::msl::speculative_history<HISTORY_RING_BITS, 0>;
 
   /* 'perceptron_state' - stores the branch prediction and keeps information
    * such as output and history needed for updating the perceptron predictor
    */
   struct perceptron_state {
     champsim::address ip{};
-    bool prediction = false;                     // prediction: 1 for taken, 0 for not taken
-    long long int output = 0;                    // perceptron output
-    std::bitset<PERCEPTRON_HISTORY> history = 0; // value of the history register yielding this prediction
+    bool prediction = false;  // prediction: 1 for taken, 0 for not taken
+    long long int output = 0; // perceptron output
+    history_type history{};   // value of the history register yielding this prediction
+    typename speculative_history_type::checkpoint checkpoint = {}; // the global history before this branch was pushed into it
+    bool in_history = false;                                        // whether this was a branch, so that it was pushed
   };
 
-  std::array<internal_perceptron<PERCEPTRON_HISTORY, PERCEPTRON_BITS>, NUM_PERCEPTRONS> perceptrons; // table of perceptrons
-  std::deque<perceptron_state> perceptron_state_buf;                                                 // state for updating perceptron predictor
-  std::bitset<PERCEPTRON_HISTORY> spec_global_history;                                               // speculative global history - updated by predictor
-  std::bitset<PERCEPTRON_HISTORY> global_history;                                                    // real global history - updated when the predictor is
-                                                                                                     // updated
+  using state_buffer_type = champsim::msl::sequence_ring<perceptron_state, NUM_UPDATE_ENTRIES>;
+
+  std::array<perceptron_type, NUM_PERCEPTRONS> perceptrons; // table of perceptrons
+  state_buffer_type perceptron_state_buf;                   // state for updating perceptron predictor, by prediction
+  speculative_history_type global_history;                  // global history - updated by predictor, repaired on mispredicts
+  long long last_output = 0;                                // output of the last prediction
 
   using branch_predictor::branch_predictor;
 
-  bool predict_branch(champsim::address ip);
-  void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+  bool predict_branch(prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type);
+  void last_branch_result(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+  void repair_branch_history(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+
+  // Without identifiers, each branch is resolved before the next is predicted
+  bool predict_branch(champsim::address ip)
+  {
+    return predict_branch(perceptron_state_buf.last() + 1, ip, champsim::address{}, false, BRANCH_CONDITIONAL);
+  }
+  void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type)
+  {
+    last_branch_result(perceptron_state_buf.last(), ip, branch_target, taken, branch_type);
+  }
+
+  // the magnitude of the last output relative to the training threshold, up to 1
+  [[nodiscard]] float prediction_confidence() const
+  {
+    return std::min(1.0f, static_cast<float>(last_output < 0 ? -last_output : last_output) / static_cast<float>(THETA));
+  }
+
+  // the weights, and the history with a checkpoint to repair it from
+  [[nodiscard]] static constexpr std::size_t storage_bits()
+  {
+    return NUM_PERCEPTRONS * (PERCEPTRON_HISTORY + 1) * PERCEPTRON_BITS + 2 * PERCEPTRON_HISTORY;
+  }
+
+  // The state buffer only holds branches that are in flight, so it is not part of a snapshot
+  template <typename Archive>
+  void snapshot_branch_predictor(Archive& archive)
+  {
+    archive(perceptrons);
+    global_history.snapshot(archive);
+  }
+};
+
+struct perceptron : basic_perceptron<0> {
+  using basic_perceptron::basic_perceptron;
 };
 
+template <int LOG_SCALE>
 template <std::size_t HISTLEN, std::size_t BITS>
-auto perceptron::internal_perceptron<HISTLEN, BITS>::predict(std::bitset<HISTLEN> history) -> typename counter_type::value_type
+long long basic_perceptron<LOG_SCALE>::internal_perceptron<HISTLEN, BITS>::predict(const history_type& history) const
 {
-  auto output = bias.value();
-
-  // find the (rest of the) dot product of the history register and the perceptron weights.
-  for (std::size_t i = 0; i < std::size(history); i++) {
-    if (history[i])
-      output += weights[i].value();
-    else
-      output -= weights[i].value();
-  }
-
-  return output;
+  // the bias, plus the dot product of the history register (as +1 and -1) and the perceptron weights
+  return bias + perceptron_kernel::output(std::data(weights), history.data(), HISTLEN);
 }
 
+template <int LOG_SCALE>
 template <std::size_t HISTLEN, std::size_t BITS>
-void perceptron::internal_perceptron<HISTLEN, BITS>::update(bool result, std::bitset<HISTLEN> history)
+void basic_perceptron<LOG_SCALE>::internal_perceptron<HISTLEN, BITS>::update(bool result, const history_type& history)
 {
   // if the branch was taken, increment the bias weight, else decrement it, with saturating arithmetic
-  bias += result ? 1 : -1;
-
-  // for each weight and corresponding bit in the history register...
-  auto upd_mask = result ? history : ~history; // if the i'th bit in the history positively
-                                               // correlates with this branch outcome,
-  for (std::size_t i = 0; i < std::size(upd_mask); i++) {
-    // increment the corresponding weight, else decrement it, with saturating arithmetic
-    weights[i] += upd_mask[i] ? 1 : -1;
-  }
+  if (result && bias < WEIGHT_MAX)
+    ++bias;
+  else if (!result && bias > WEIGHT_MIN)
+    --bias;
+
+  // increment each weight whose history bit positively correlates with this branch outcome, else decrement it, with saturating
+  // arithmetic
+  perceptron_kernel::train(std::data(weights), history.data(), HISTLEN, result, WEIGHT_MIN, WEIGHT_MAX);
 }
 
 #endif
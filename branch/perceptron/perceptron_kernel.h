@@ -0,0 +1,262 @@
+#ifndef BRANCH_PERCEPTRON_KERNEL_H
+#define BRANCH_PERCEPTRON_KERNEL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define PERCEPTRON_KERNEL_X86 1
+#endif
+
+/*
+ * Kernels for the output and training of perceptrons with int8 weights.
+ *
+ * The weights of a perceptron are a contiguous array of int8, zero-padded to a multiple of VECTOR_BYTES. The history is packed,
+ * with history bit i in bit (i % 64) of word (i / 64). The output is the sum of the weights whose history bit is set, less the sum
+ * of those whose bit is clear. Training moves each weight by one toward the agreement of its history bit with the outcome,
+ * saturating at the given bounds. The padding is never trained, so it stays zero and never contributes to the output.
+ *
+ * Each kernel has a scalar version and, on x86-64, SSE2 and AVX2 versions, which all give identical results. The AVX2 versions are
+ * used whenever the host supports them, whatever the compiler flags.
+ */
+namespace perceptron_kernel
+{
+constexpr std::size_t VECTOR_BYTES = 32;
+
+constexpr std::size_t padded_length(std::size_t histlen) { return ((histlen + VECTOR_BYTES - 1) / VECTOR_BYTES) * VECTOR_BYTES; }
+
+template <std::size_t HISTLEN>
+using weight_vector = std::array<int8_t, padded_length(HISTLEN)>;
+
+/**
+ * A global history of HISTLEN outcomes, packed for the kernels. Bit 0 is the most recent.
+ */
+template <std::size_t HISTLEN>
+class history_register
+{
+  static constexpr std::size_t WORDS = (padded_length(HISTLEN) + 63) / 64;
+  static_assert(WORDS == (HISTLEN + 63) / 64, "The padding must not need a word of its own");
+
+  std::array<uint64_t, WORDS> words = {};
+
+public:
+  history_register() = default;
+
+  // The most recent HISTLEN outcomes of a history that gives the outcome pushed some number of pushes ago by at(), as a speculative_history does
+  template <typename History>
+  [[nodiscard]] static history_register recent(const History& history)
+  {
+    history_register result;
+    for (std::size_t i = 0; i < HISTLEN; ++i)
+      result.words[i / 64] |= uint64_t{history.at(i)} << (i % 64);
+    return result;
+  }
+
+  void push(bool taken)
+  {
+    for (auto i = WORDS - 1; i > 0; --i)
+      words[i] = (words[i] << 1) | (words[i - 1] >> 63);
+    words[0] = (words[0] << 1) | (taken ? 1 : 0);
+
+    if constexpr (HISTLEN % 64 != 0)
+      words[WORDS - 1] &= (uint64_t{1} << (HISTLEN % 64)) - 1;
+  }
+
+  bool operator[](std::size_t i) const { return ((words[i / 64] >> (i % 64)) & 1) != 0; }
+  const uint64_t* data() const { return words.data(); }
+
+  friend bool operator==(const history_register& lhs, const history_register& rhs) { return lhs.words == rhs.words; }
+  friend bool operator!=(const history_register& lhs, const history_register& rhs) { return !(lhs == rhs); }
+};
+
+namespace scalar
+{
+inline long long output(const int8_t* weights, const uint64_t* history, std::size_t length)
+{
+  long long result = 0;
+  for (std::size_t i = 0; i < length; ++i) {
+    if ((history[i / 64] >> (i % 64)) & 1)
+      result += weights[i];
+    else
+      result -= weights[i];
+  }
+  return result;
+}
+
+inline void train(int8_t* weights, const uint64_t* history, std::size_t length, bool taken, int8_t lower, int8_t upper)
+{
+  for (std::size_t i = 0; i < length; ++i) {
+    const bool agrees = (((history[i / 64] >> (i % 64)) & 1) != 0) == taken;
+    if (agrees && weights[i] < upper)
+      ++weights[i];
+    else if (!agrees && weights[i] > lower)
+      --weights[i];
+  }
+}
+} // namespace scalar
+
+#ifdef PERCEPTRON_KERNEL_X86
+/*
+ * The vector kernels expand the history into a byte mask, one byte per weight. The output is found from two sums of bytes: the sum
+ * of all of the weights, and the sum of the weights that are selected by the mask. Then the output is (2 * selected - all). The sums
+ * are taken with SAD on the weights biased to unsigned (w + 128), which cannot overflow, and the bias is subtracted afterward.
+ */
+namespace sse2
+{
+// The 16 history bits starting at the given bit, which must be a multiple of 16
+inline unsigned history_bits(const uint64_t* history, std::size_t first) { return static_cast<unsigned>((history[first / 64] >> (first % 64)) & 0xffff); }
+
+inline __m128i expand(unsigned bits)
+{
+  const auto select = _mm_set1_epi64x(static_cast<long long>(0x8040201008040201ull));
+  const auto spread = _mm_unpacklo_epi64(_mm_set1_epi8(static_cast<char>(bits & 0xff)), _mm_set1_epi8(static_cast<char>(bits >> 8)));
+  return _mm_cmpeq_epi8(_mm_and_si128(spread, select), select);
+}
+
+inline long long output(const int8_t* weights, const uint64_t* history, std::size_t length)
+{
+  const auto bias = _mm_set1_epi8(static_cast<char>(0x80));
+  auto all = _mm_setzero_si128();
+  auto selected = _mm_setzero_si128();
+  long long lanes = 0;
+  long long set_bits = 0;
+  for (std::size_t i = 0; i < length; i += 16) {
+    const auto bits = history_bits(history, i);
+    const auto biased = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i)), bias);
+    all = _mm_add_epi64(all, _mm_sad_epu8(biased, _mm_setzero_si128()));
+    selected = _mm_add_epi64(selected, _mm_sad_epu8(_mm_and_si128(biased, expand(bits)), _mm_setzero_si128()));
+    lanes += 16;
+    set_bits += __builtin_popcount(bits);
+  }
+
+  const auto sum_all = _mm_cvtsi128_si64(all) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(all, all)) - 128 * lanes;
+  const auto sum_selected = _mm_cvtsi128_si64(selected) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(selected, selected)) - 128 * set_bits;
+  return 2 * sum_selected - sum_all;
+}
+
+inline void train(int8_t* weights, const uint64_t* history, std::size_t length, bool taken, int8_t lower, int8_t upper)
+{
+  const auto one = _mm_set1_epi8(1);
+  const auto flip = taken ? _mm_setzero_si128() : _mm_set1_epi8(-1);
+  const auto above = _mm_set1_epi8(static_cast<char>(upper + 1));
+  const auto below = _mm_set1_epi8(static_cast<char>(lower - 1));
+  for (std::size_t i = 0; i < length; i += 16) {
+    const auto remaining = length - i;
+    const auto valid = expand(remaining >= 16 ? 0xffffu : ((1u << remaining) - 1));
+    const auto agrees = _mm_xor_si128(expand(history_bits(history, i)), flip);
+
+    // +1 where the bit agrees, -1 where it does not, and 0 in the padding
+    const auto step = _mm_and_si128(_mm_or_si128(_mm_andnot_si128(agrees, _mm_set1_epi8(-1)), one), valid);
+
+    auto* target = reinterpret_cast<__m128i*>(weights + i);
+    auto updated = _mm_adds_epi8(_mm_loadu_si128(target), step);
+    if (upper < INT8_MAX)
+      updated = _mm_add_epi8(updated, _mm_cmpeq_epi8(updated, above)); // Step back down from upper + 1
+    if (lower > INT8_MIN)
+      updated = _mm_sub_epi8(updated, _mm_cmpeq_epi8(updated, below)); // Step back up from lower - 1
+    _mm_storeu_si128(target, updated);
+  }
+}
+} // namespace sse2
+
+namespace avx2
+{
+// The 32 history bits starting at the given bit, which must be a multiple of 32
+inline uint32_t history_bits(const uint64_t* history, std::size_t first) { return static_cast<uint32_t>(history[first / 64] >> (first % 64)); }
+
+__attribute__((target("avx2"))) inline __m256i expand(uint32_t bits)
+{
+  const auto select = _mm256_set1_epi64x(static_cast<long long>(0x8040201008040201ull));
+  const auto spread = _mm256_shuffle_epi8(_mm256_set1_epi32(static_cast<int>(bits)),
+                                          _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3));
+  return _mm256_cmpeq_epi8(_mm256_and_si256(spread, select), select);
+}
+
+__attribute__((target("avx2"))) inline long long horizontal_sum(__m256i x)
+{
+  const auto halves = _mm_add_epi64(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+  return _mm_cvtsi128_si64(halves) + _mm_cvtsi128_si64(_mm_unpackhi_epi64(halves, halves));
+}
+
+__attribute__((target("avx2"))) inline long long output(const int8_t* weights, const uint64_t* history, std::size_t length)
+{
+  const auto bias = _mm256_set1_epi8(static_cast<char>(0x80));
+  auto all = _mm256_setzero_si256();
+  auto selected = _mm256_setzero_si256();
+  long long lanes = 0;
+  long long set_bits = 0;
+  for (std::size_t i = 0; i < length; i += 32) {
+    const auto bits = history_bits(history, i);
+    const auto biased = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i)), bias);
+    all = _mm256_add_epi64(all, _mm256_sad_epu8(biased, _mm256_setzero_si256()));
+    selected = _mm256_add_epi64(selected, _mm256_sad_epu8(_mm256_and_si256(biased, expand(bits)), _mm256_setzero_si256()));
+    lanes += 32;
+    set_bits += __builtin_popcount(bits);
+  }
+
+  return 2 * (horizontal_sum(selected) - 128 * set_bits) - (horizontal_sum(all) - 128 * lanes);
+}
+
+__attribute__((target("avx2"))) inline void train(int8_t* weights, const uint64_t* history, std::size_t length, bool taken, int8_t lower, int8_t upper)
+{
+  const auto one = _mm256_set1_epi8(1);
+  const auto flip = taken ? _mm256_setzero_si256() : _mm256_set1_epi8(-1);
+  const auto above = _mm256_set1_epi8(static_cast<char>(upper + 1));
+  const auto below = _mm256_set1_epi8(static_cast<char>(lower - 1));
+  for (std::size_t i = 0; i < length; i += 32) {
+    const auto remaining = length - i;
+    const auto valid = expand(remaining >= 32 ? 0xffffffffu : static_cast<uint32_t>((uint64_t{1} << remaining) - 1));
+    const auto agrees = _mm256_xor_si256(expand(history_bits(history, i)), flip);
+
+    // +1 where the bit agrees, -1 where it does not, and 0 in the padding
+    const auto step = _mm256_and_si256(_mm256_or_si256(_mm256_andnot_si256(agrees, _mm256_set1_epi8(-1)), one), valid);
+
+    auto* target = reinterpret_cast<__m256i*>(weights + i);
+    auto updated = _mm256_adds_epi8(_mm256_loadu_si256(target), step);
+    if (upper < INT8_MAX)
+      updated = _mm256_add_epi8(updated, _mm256_cmpeq_epi8(updated, above)); // Step back down from upper + 1
+    if (lower > INT8_MIN)
+      updated = _mm256_sub_epi8(updated, _mm256_cmpeq_epi8(updated, below)); // Step back up from lower - 1
+    _mm256_storeu_si256(target, updated);
+  }
+}
+
+inline const bool supported = [] {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+}();
+} // namespace avx2
+#endif
+
+/**
+ * The output of a perceptron. The weights must be padded as by weight_vector.
+ */
+inline long long output(const int8_t* weights, const uint64_t* history, std::size_t length)
+{
+#ifdef PERCEPTRON_KERNEL_X86
+  if (avx2::supported)
+    return avx2::output(weights, history, length);
+  return sse2::output(weights, history, length);
+#else
+  return scalar::output(weights, history, length);
+#endif
+}
+
+/**
+ * Train a perceptron on an outcome. The weights must be padded as by weight_vector, and the bounds must not be wider than int8.
+ */
+inline void train(int8_t* weights, const uint64_t* history, std::size_t length, bool taken, int8_t lower, int8_t upper)
+{
+#ifdef PERCEPTRON_KERNEL_X86
+  if (avx2::supported)
+    return avx2::train(weights, history, length, taken, lower, upper);
+  return sse2::train(weights, history, length, taken, lower, upper);
+#else
+  return scalar::train(weights, history, length, taken, lower, upper);
+#endif
+}
+} // namespace perceptron_kernel
+
+#endif
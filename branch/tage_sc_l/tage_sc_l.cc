@@ -0,0 +1,323 @@
+#include "tage_sc_l.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fmt/core.h>
+
+#include "instruction.h"
+
+namespace
+{
+template <typename T>
+void saturating_update(T& counter, bool up, int minimum, int maximum)
+{
+  if (up && counter < maximum)
+    ++counter;
+  else if (!up && counter > minimum)
+    --counter;
+}
+
+constexpr uint64_t mask(std::size_t bits) { return (uint64_t{1} << bits) - 1; }
+} // namespace
+
+template <int LOG_SCALE>
+bool basic_tage_sc_l<LOG_SCALE>::predict_branch(prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken,
+                                                uint8_t branch_type)
+{
+  const auto pc = ip.to<uint64_t>();
+  prediction_state state;
+  state.ip = ip;
+
+  lookup_tage(pc, state);
+  lookup_loop(pc, state);
+  state.base_prediction = (state.loop_valid && counters.with_loop >= 0) ? state.loop_prediction : state.tage_prediction;
+  lookup_corrector(pc, state);
+
+  // branches enter the history as they are predicted, and it is rolled back if they were mispredicted
+  if (branch_type != NOT_BRANCH) {
+    state.path = path;
+    state.checkpoint = history.speculate(state.prediction || always_taken);
+    state.in_history = true;
+    push_path(pc);
+  }
+
+  state_buf.push(id, state);
+  return state.prediction;
+}
+
+template <int LOG_SCALE>
+void basic_tage_sc_l<LOG_SCALE>::repair_branch_history(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken,
+                                                       uint8_t branch_type)
+{
+  auto* state = state_buf.find(id);
+  if (state != nullptr && state->in_history && history.repair(state->checkpoint, taken)) {
+    path = state->path;
+    push_path(ip.to<uint64_t>());
+  }
+}
+
+template <int LOG_SCALE>
+void basic_tage_sc_l<LOG_SCALE>::lookup_tage(uint64_t pc, prediction_state& state)
+{
+  for (std::size_t table = 0; table < NUM_TAGGED_TABLES; ++table) {
+    const auto table_path = path & mask(std::min(HISTORY_LENGTHS[table], PATH_HISTORY_BITS));
+    const auto pc_hash = pc ^ (pc >> (static_cast<std::size_t>(std::abs(static_cast<int>(LOG_TAGGED_ENTRIES) - static_cast<int>(table))) + 1));
+    state.indices[table] = static_cast<uint16_t>((pc_hash ^ history.folded(INDEX_FOLDS + table) ^ table_path ^ (table_path >> (table + 1))) & mask(LOG_TAGGED_ENTRIES));
+    state.tags[table] = static_cast<uint16_t>(((pc ^ history.folded(TAG_FOLDS + table) ^ (history.folded(TAG_FOLDS + NUM_TAGGED_TABLES + table) << 1)) & mask(TAG_BITS[table])) | VALID_TAG_BIT);
+  }
+  state.bimodal_index = static_cast<uint16_t>((pc ^ (pc >> LOG_BIMODAL_ENTRIES)) & mask(LOG_BIMODAL_ENTRIES));
+
+  // the longest matching table provides the prediction, and the next longest is the alternate
+  for (auto table = static_cast<int>(NUM_TAGGED_TABLES) - 1; table >= 0; --table) {
+    if (tagged_at(static_cast<std::size_t>(table), state.indices[table]).tag == state.tags[table]) {
+      if (state.provider < 0) {
+        state.provider = static_cast<int8_t>(table);
+      } else {
+        state.alternate = static_cast<int8_t>(table);
+        break;
+      }
+    }
+  }
+
+  const bool bimodal_prediction = bimodal[state.bimodal_index] >= 2;
+  state.alternate_prediction = (state.alternate >= 0) ? (tagged_at(state.alternate, state.indices[state.alternate]).counter >= 0) : bimodal_prediction;
+
+  if (state.provider >= 0) {
+    const auto& entry = tagged_at(state.provider, state.indices[state.provider]);
+    state.provider_prediction = entry.counter >= 0;
+    state.provider_is_new = (entry.counter == 0 || entry.counter == -1) && entry.useful == 0;
+    state.tage_prediction = (state.provider_is_new && counters.use_alternate >= 0) ? state.alternate_prediction : state.provider_prediction;
+    last_confidence = static_cast<float>(std::abs(2 * entry.counter + 1) - 1) / static_cast<float>(2 * COUNTER_MAX);
+  } else {
+    state.provider_prediction = bimodal_prediction;
+    state.tage_prediction = bimodal_prediction;
+    last_confidence = decltype(bimodal)::strength(bimodal[state.bimodal_index]);
+  }
+}
+
+template <int LOG_SCALE>
+void basic_tage_sc_l<LOG_SCALE>::lookup_loop(uint64_t pc, prediction_state& state)
+{
+  const auto set = (pc ^ (pc >> 4)) % LOOP_SETS;
+  const auto tag = static_cast<uint16_t>((pc >> 4) & mask(LOOP_TAG_BITS));
+  for (std::size_t way = 0; way < LOOP_WAYS; ++way) {
+    const auto& entry = loops[set * LOOP_WAYS + way];
+    if (entry.valid && entry.tag == tag) {
+      state.loop_way = static_cast<int8_t>(way);
+      state.loop_valid = entry.confidence == LOOP_CONFIDENCE_MAX && entry.trip_count > 0;
+      state.loop_prediction = (entry.current_iteration == entry.trip_count) ? !entry.direction : entry.direction;
+      return;
+    }
+  }
+}
+
+template <int LOG_SCALE>
+void basic_tage_sc_l<LOG_SCALE>::lookup_corrector(uint64_t pc, prediction_state& state)
+{
+  const auto base = state.base_prediction ? 1u : 0u;
+  state.sc_indices[0] = static_cast<uint16_t>((((pc ^ (pc >> LOG_SC_ENTRIES)) << 1) | base) & mask(LOG_SC_ENTRIES));
+  for (std::size_t table = 1; table < NUM_SC_TABLES; ++table)
+    state.sc_indices[table] = static_cast<uint16_t>(((((pc ^ (pc >> (table + 1))) ^ history.folded(SC_FOLDS + table - 1)) << 1) | base) & mask(LOG_SC_ENTRIES));
+
+  // the sum starts from the confidence of the prediction it may correct
+  int confidence = 8;
+  if (state.loop_valid && counters.with_loop >= 0)
+    confidence = 64;
+  else if (state.provider >= 0 && state.tage_prediction == state.provider_prediction)
+    confidence = std::abs(2 * tagged_at(state.provider, state.indices[state.provider]).counter + 1) * 8;
+
+  int sum = state.base_prediction ? confidence : -confidence;
+  for (std::size_t table = 0; table < NUM_SC_TABLES; ++table)
+    sum += 2 * corrector_at(table, state.sc_indices[table]) + 1;
+  state.sc_sum = sum;
+
+  const bool sc_prediction = sum >= 0;
+  state.prediction = (sc_prediction != state.base_prediction && std::abs(sum) >= counters.sc_threshold) ? sc_prediction : state.base_prediction;
+}
+
+template <int LOG_SCALE>
+void basic_tage_sc_l<LOG_SCALE>::last_branch_result(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken,
+                                                    uint8_t branch_type)
+{
+  const auto pc = ip.to<uint64_t>();
+
+  auto* state = state_buf.find(id);
+  if (state == nullptr)
+    return; // the prediction was lost, so it cannot be trained, and the branch already entered the history when it was predicted
+
+  // the branch was pushed into the history when it was predicted, and is repaired now if that has not been done already
+  if (state->in_history) {
+    repair_branch_history(id, ip, branch_target, taken, branch_type);
+  } else {
+    history.push(taken);
+    push_path(pc);
+  }
+
+  // the indices and tags were computed from the history at the time of the prediction
+  if (state->ip == ip && (branch_type == BRANCH_CONDITIONAL || branch_type == BRANCH_OTHER)) {
+    update_corrector(*state, taken);
+    update_loop(pc, *state, taken);
+    update_tage(*state, taken);
+  }
+  state_buf.erase(id);
+}
+
+template <int LOG_SCALE>
+void basic_tage_sc_l<LOG_SCALE>::update_tage(const prediction_state& state, bool taken)
+{
+  // allocate an entry in a longer table if the prediction was wrong, preferring a short one but sometimes skipping one to spread
+  // the allocations out
+  if (state.tage_prediction != taken && state.provider < static_cast<int>(NUM_TAGGED_TABLES) - 1) {
+    auto first = static_cast<std::size_t>(state.provider + 1);
+    if (first + 1 < NUM_TAGGED_TABLES && (rng() & 1) != 0)
+      ++first;
+
+    bool allocated = false;
+    for (auto table = first; table < NUM_TAGGED_TABLES && !allocated; ++table) {
+      auto& entry = tagged_at(table, state.indices[table]);
+      if (entry.useful == 0) {
+        entry = tagged_entry{state.tags[table], static_cast<int8_t>(taken ? 0 : -1), 0};
+        allocated = true;
+      }
+    }
+
+    if (!allocated) {
+      // no entry was free, so age the candidates to make room for a later allocation
+      for (auto table = static_cast<std::size_t>(state.provider + 1); table < NUM_TAGGED_TABLES; ++table) {
+        auto& entry = tagged_at(table, state.indices[table]);
+        if (entry.useful > 0)
+          --entry.useful;
+      }
+    }
+  }
+
+  if (state.provider >= 0) {
+    auto& entry = tagged_at(state.provider, state.indices[state.provider]);
+
+    // learn whether a new entry or the alternate prediction is more trustworthy
+    if (state.provider_is_new && state.provider_prediction != state.alternate_prediction)
+      saturating_update(counters.use_alternate, state.alternate_prediction == taken, -8, 7);
+
+    // a new entry is not yet trusted, so the alternate keeps learning too
+    if (state.provider_is_new) {
+      if (state.alternate >= 0)
+        saturating_update(tagged_at(state.alternate, state.indices[state.alternate]).counter, taken, COUNTER_MIN, COUNTER_MAX);
+      else
+        bimodal.update(state.bimodal_index, taken);
+    }
+
+    saturating_update(entry.counter, taken, COUNTER_MIN, COUNTER_MAX);
+    if (state.provider_prediction != state.alternate_prediction)
+      saturating_update(entry.useful, state.provider_prediction == taken, 0, USEFUL_MAX);
+  } else {
+    bimodal.update(state.bimodal_index, taken);
+  }
+
+  // periodically age every entry, so that entries that were once useful can be replaced
+  if (++counters.branch_count % USEFUL_RESET_PERIOD == 0) {
+    for (auto& entry : tagged)
+      entry.useful >>= 1;
+  }
+}
+
+template <int LOG_SCALE>
+void basic_tage_sc_l<LOG_SCALE>::update_loop(uint64_t pc, const prediction_state& state, bool taken)
+{
+  const auto set = (pc ^ (pc >> 4)) % LOOP_SETS;
+  const auto tag = static_cast<uint16_t>((pc >> 4) & mask(LOOP_TAG_BITS));
+  const auto begin = std::next(std::begin(loops), static_cast<long>(set * LOOP_WAYS));
+  const auto end = std::next(begin, LOOP_WAYS);
+
+  if (state.loop_way < 0) {
+    // only a branch that TAGE mispredicts is a candidate, and its outcome is taken to be the exit of the loop
+    if (state.tage_prediction == taken)
+      return;
+
+    auto victim = std::find_if(begin, end, [](const auto& entry) { return !entry.valid || entry.age == 0; });
+    if (victim != end) {
+      *victim = loop_entry{tag, 0, 0, 0, LOOP_AGE_MAX, !taken, true};
+    } else {
+      std::for_each(begin, end, [](auto& entry) { --entry.age; });
+    }
+    return;
+  }
+
+  auto& entry = *std::next(begin, state.loop_way);
+  if (!entry.valid || entry.tag != tag)
+    return; // the entry was replaced since the prediction
+
+  if (state.loop_valid) {
+    // learn whether to trust the loop predictor over TAGE
+    if (state.loop_prediction != state.tage_prediction) {
+      saturating_update(counters.with_loop, state.loop_prediction == taken, -64, 63);
+      if (state.loop_prediction == taken && entry.age < LOOP_AGE_MAX)
+        ++entry.age;
+    }
+
+    // a confident prediction that was wrong means the branch is not a loop with a constant trip count
+    if (state.loop_prediction != taken) {
+      entry = loop_entry{};
+      return;
+    }
+  }
+
+  if (taken == entry.direction) {
+    if (++entry.current_iteration == mask(LOOP_ITERATION_BITS))
+      entry = loop_entry{}; // too long to track
+  } else if (entry.current_iteration == 0) {
+    entry = loop_entry{}; // two exits in a row, so the direction of the body was guessed wrong
+  } else {
+    if (entry.current_iteration == entry.trip_count) {
+      entry.confidence = static_cast<uint8_t>(std::min<unsigned>(entry.confidence + 1u, LOOP_CONFIDENCE_MAX));
+    } else {
+      entry.trip_count = entry.current_iteration;
+      entry.confidence = 0;
+    }
+    entry.current_iteration = 0;
+  }
+}
+
+template <int LOG_SCALE>
+void basic_tage_sc_l<LOG_SCALE>::update_corrector(const prediction_state& state, bool taken)
+{
+  const bool sc_prediction = state.sc_sum >= 0;
+
+  // adjust the threshold when the corrector disagreed with the prediction it may correct, as in O-GEHL
+  if (sc_prediction != state.base_prediction) {
+    constexpr int SPEED = 32;
+    counters.sc_threshold_tc += (sc_prediction == taken) ? -1 : 1;
+    if (counters.sc_threshold_tc >= SPEED) {
+      counters.sc_threshold = std::min(counters.sc_threshold + 1, 127);
+      counters.sc_threshold_tc = 0;
+    } else if (counters.sc_threshold_tc <= -SPEED) {
+      counters.sc_threshold = std::max(counters.sc_threshold - 1, 4);
+      counters.sc_threshold_tc = 0;
+    }
+  }
+
+  if (sc_prediction != taken || std::abs(state.sc_sum) < counters.sc_threshold) {
+    for (std::size_t table = 0; table < NUM_SC_TABLES; ++table)
+      saturating_update(corrector_at(table, state.sc_indices[table]), taken, SC_COUNTER_MIN, SC_COUNTER_MAX);
+  }
+}
+
+template <int LOG_SCALE>
+void basic_tage_sc_l<LOG_SCALE>::push_path(uint64_t pc)
+{
+  path = static_cast<uint32_t>(((path << 1) | ((pc ^ (pc >> 2)) & 1)) & mask(PATH_HISTORY_BITS));
+}
+
+template <int LOG_SCALE>
+void basic_tage_sc_l<LOG_SCALE>::branch_predictor_final_stats() const
+{
+  fmt::print("TAGE-SC-L storage: {} bits ({:.1f} KiB)\n", storage_bits(), static_cast<double>(storage_bits()) / 8192);
+}
+
+// every scale from branch_predictor::MIN_LOG_SCALE to MAX_LOG_SCALE
+template class basic_tage_sc_l<-4>;
+template class basic_tage_sc_l<-3>;
+template class basic_tage_sc_l<-2>;
+template class basic_tage_sc_l<-1>;
+template class basic_tage_sc_l<0>;
+template class basic_tage_sc_l<1>;
+template class basic_tage_sc_l<2>;
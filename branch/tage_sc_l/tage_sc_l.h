@@ -0,0 +1,226 @@
+#ifndef BRANCH_TAGE_SC_L_H
+#define BRANCH_TAGE_SC_L_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include "instruction.h"
+#include "modules.h"
+#include "msl/packed_counter_array.h"
+#include "msl/sequence_ring.h"
+#include "msl/speculative_history.h"
+#include "msl/xoshiro.h"
+
+/*
+ * A TAGE-SC-L predictor, after Seznec, "TAGE-SC-L Branch Predictors Again," CBP 2016.
+ *
+ * A bimodal table is backed by tagged tables indexed with geometrically longer global histories. The longest matching table
+ * provides the prediction, which a loop predictor may override for loops with a constant trip count. A statistical corrector,
+ * a sum of counters from tables indexed with shorter histories, may override the result when it confidently disagrees.
+ *
+ * This keeps the structure of the original but is much simpler in its details. The tables are sized by the constants below. Each
+ * tagged entry (tag, counter, and useful bits) is kept together in one four-byte struct, so a lookup touches one cache line per
+ * table, and the folded histories are updated in constant time per branch. The history is updated as branches are predicted, and
+ * rolled back from a checkpoint when one is mispredicted.
+ *
+ * The tagged, bimodal, and corrector tables are scaled by 2^LOG_SCALE from the sizes below. The tage_sc_l module is the default size.
+ */
+template <int LOG_SCALE>
+class basic_tage_sc_l : public champsim::modules::branch_predictor
+{
+public:
+  // The tagged tables, with their history lengths (a geometric series) and tag widths
+  constexpr static std::size_t NUM_TAGGED_TABLES = 12;
+  constexpr static std::array<std::size_t, NUM_TAGGED_TABLES> HISTORY_LENGTHS = {4, 6, 10, 16, 25, 40, 64, 101, 160, 254, 403, 640};
+  constexpr static std::array<std::size_t, NUM_TAGGED_TABLES> TAG_BITS = {7, 7, 8, 8, 9, 10, 11, 12, 12, 13, 14, 15};
+  constexpr static std::size_t LOG_TAGGED_ENTRIES = 10 + LOG_SCALE;
+  constexpr static std::size_t COUNTER_BITS = 3;
+  constexpr static std::size_t USEFUL_BITS = 2;
+  constexpr static std::size_t LOG_BIMODAL_ENTRIES = 13 + LOG_SCALE;
+  constexpr static std::size_t PATH_HISTORY_BITS = 16;
+  constexpr static uint64_t USEFUL_RESET_PERIOD = 1 << 18; // branches between the aging of every useful counter
+
+  // The loop predictor
+  constexpr static std::size_t LOOP_SETS = 16;
+  constexpr static std::size_t LOOP_WAYS = 4;
+  constexpr static std::size_t LOOP_TAG_BITS = 14;
+  constexpr static std::size_t LOOP_ITERATION_BITS = 14;
+  constexpr static unsigned LOOP_CONFIDENCE_MAX = 3;
+  constexpr static unsigned LOOP_AGE_MAX = 7;
+
+  // The statistical corrector: a bias table, and one table for each of these history lengths
+  constexpr static std::array<std::size_t, 4> SC_HISTORY_LENGTHS = {6, 11, 19, 32};
+  constexpr static std::size_t NUM_SC_TABLES = 1 + std::size(SC_HISTORY_LENGTHS);
+  constexpr static std::size_t LOG_SC_ENTRIES = 10 + LOG_SCALE;
+  constexpr static std::size_t SC_COUNTER_BITS = 6;
+
+  /**
+   * The number of bits of state the predictor would need in hardware.
+   */
+  [[nodiscard]] constexpr static std::size_t storage_bits();
+
+  using branch_predictor::branch_predictor;
+  bool predict_branch(prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type);
+  void last_branch_result(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+  void repair_branch_history(prediction_id id, champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+
+  // Without identifiers, each branch is resolved before the next is predicted
+  bool predict_branch(champsim::address ip) { return predict_branch(state_buf.last() + 1, ip, champsim::address{}, false, BRANCH_CONDITIONAL); }
+  void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type)
+  {
+    last_branch_result(state_buf.last(), ip, branch_target, taken, branch_type);
+  }
+  void branch_predictor_final_stats() const;
+
+  // the strength of the counter that provided the last TAGE prediction, 0 when it is weak and 1 when it is saturated
+  [[nodiscard]] float prediction_confidence() const { return last_confidence; }
+
+  template <typename Archive>
+  void snapshot_branch_predictor(Archive& archive)
+  {
+    archive(bimodal);
+    archive(tagged);
+    archive(loops);
+    archive(corrector);
+    history.snapshot(archive);
+    archive(path);
+    archive(counters);
+    archive(rng);
+  }
+
+private:
+  constexpr static std::size_t TAGGED_ENTRIES = std::size_t{1} << LOG_TAGGED_ENTRIES;
+  constexpr static std::size_t SC_ENTRIES = std::size_t{1} << LOG_SC_ENTRIES;
+  constexpr static std::size_t NUM_UPDATE_ENTRIES = MAX_PREDICTIONS_IN_FLIGHT;
+  constexpr static std::size_t HISTORY_RING_BITS = 2048;  // the longest history, and every branch that may be pushed before a repair
+  static_assert(HISTORY_RING_BITS >= HISTORY_LENGTHS.back() + NUM_UPDATE_ENTRIES);
+
+  // The folds of the global history: one for the index of each tagged table, two for its tag, and one for each corrector table
+  constexpr static std::size_t INDEX_FOLDS = 0;
+  constexpr static std::size_t TAG_FOLDS = INDEX_FOLDS + NUM_TAGGED_TABLES;
+  constexpr static std::size_t SC_FOLDS = TAG_FOLDS + 2 * NUM_TAGGED_TABLES;
+  constexpr static std::size_t NUM_FOLDS = SC_FOLDS + std::size(SC_HISTORY_LENGTHS);
+  using history_type = champsim::msl::speculative_history<HISTORY_RING_BITS, NUM_FOLDS>;
+
+  constexpr static int COUNTER_MAX = (1 << (COUNTER_BITS - 1)) - 1;
+  constexpr static int COUNTER_MIN = -(1 << (COUNTER_BITS - 1));
+  constexpr static int USEFUL_MAX = (1 << USEFUL_BITS) - 1;
+  constexpr static int SC_COUNTER_MAX = (1 << (SC_COUNTER_BITS - 1)) - 1;
+  constexpr static int SC_COUNTER_MIN = -(1 << (SC_COUNTER_BITS - 1));
+
+  // Tags are kept with a valid bit above the widest tag, so an entry that was never allocated, whose tag is 0, matches no branch
+  constexpr static uint16_t VALID_TAG_BIT = 1u << 15;
+  static_assert(*std::max_element(std::begin(TAG_BITS), std::end(TAG_BITS)) < 16);
+
+  struct tagged_entry {
+    uint16_t tag = 0; // including VALID_TAG_BIT
+    int8_t counter = 0;
+    uint8_t useful = 0;
+  };
+  static_assert(sizeof(tagged_entry) == 4);
+
+  struct loop_entry {
+    uint16_t tag = 0;
+    uint16_t current_iteration = 0; // the number of iterations since the loop was last exited
+    uint16_t trip_count = 0;        // the number of iterations between the last two exits
+    uint8_t confidence = 0;
+    uint8_t age = 0;
+    bool direction = false; // the direction of the branch in the body of the loop
+    bool valid = false;
+  };
+
+  // The counters that adapt how the components are combined
+  struct adaptive_counters {
+    int use_alternate = 0;    // whether to trust the alternate prediction over a newly allocated entry
+    int with_loop = -1;       // whether to trust the loop predictor
+    int sc_threshold = 16;    // how confident the statistical corrector must be to override
+    int sc_threshold_tc = 0;  // the counter for adjusting the threshold
+    uint64_t branch_count = 0;
+  };
+
+  // What a prediction depended on, kept until its branch is resolved
+  struct prediction_state {
+    champsim::address ip{};
+    std::array<uint16_t, NUM_TAGGED_TABLES> indices = {};
+    std::array<uint16_t, NUM_TAGGED_TABLES> tags = {}; // including VALID_TAG_BIT
+    std::array<uint16_t, NUM_SC_TABLES> sc_indices = {};
+    uint16_t bimodal_index = 0;
+    int8_t provider = -1;  // the longest matching table, or -1 for the bimodal table
+    int8_t alternate = -1; // the next longest matching table, or -1 for the bimodal table
+    int8_t loop_way = -1;
+    bool provider_prediction = false;
+    bool alternate_prediction = false;
+    bool provider_is_new = false; // the provider is weak and not yet useful, so it may have just been allocated
+    bool tage_prediction = false;
+    bool loop_valid = false;
+    bool loop_prediction = false;
+    bool base_prediction = false; // the TAGE or loop prediction, before the statistical corrector
+    bool prediction = false;
+    int sc_sum = 0;
+    typename history_type::checkpoint checkpoint = {}; // the history before this branch was pushed into it
+    uint32_t path = 0;                                 // the path history before this branch
+    bool in_history = false;                           // whether this was a branch, so that it was pushed
+  };
+
+  using state_buffer_type = champsim::msl::sequence_ring<prediction_state, NUM_UPDATE_ENTRIES>;
+
+  champsim::msl::packed_counter_array<2, std::size_t{1} << LOG_BIMODAL_ENTRIES> bimodal;
+  std::array<tagged_entry, NUM_TAGGED_TABLES * TAGGED_ENTRIES> tagged = {};
+  std::array<loop_entry, LOOP_SETS * LOOP_WAYS> loops = {};
+  std::array<int8_t, NUM_SC_TABLES * SC_ENTRIES> corrector = {};
+
+  history_type history{make_fold_shapes()};
+  uint32_t path = 0;
+  adaptive_counters counters;
+  champsim::msl::xoshiro256starstar rng{0};
+
+  state_buffer_type state_buf;
+  float last_confidence = 0;
+
+  constexpr static std::array<typename history_type::fold_shape, NUM_FOLDS> make_fold_shapes()
+  {
+    std::array<typename history_type::fold_shape, NUM_FOLDS> shapes{};
+    for (std::size_t table = 0; table < NUM_TAGGED_TABLES; ++table) {
+      shapes[INDEX_FOLDS + table] = {HISTORY_LENGTHS[table], LOG_TAGGED_ENTRIES};
+      shapes[TAG_FOLDS + table] = {HISTORY_LENGTHS[table], TAG_BITS[table]};
+      shapes[TAG_FOLDS + NUM_TAGGED_TABLES + table] = {HISTORY_LENGTHS[table], TAG_BITS[table] - 1};
+    }
+    for (std::size_t table = 0; table < std::size(SC_HISTORY_LENGTHS); ++table)
+      shapes[SC_FOLDS + table] = {SC_HISTORY_LENGTHS[table], LOG_SC_ENTRIES};
+    return shapes;
+  }
+
+  tagged_entry& tagged_at(std::size_t table, uint16_t index) { return tagged[table * TAGGED_ENTRIES + index]; }
+  int8_t& corrector_at(std::size_t table, uint16_t index) { return corrector[table * SC_ENTRIES + index]; }
+
+  void lookup_tage(uint64_t pc, prediction_state& state);
+  void lookup_loop(uint64_t pc, prediction_state& state);
+  void lookup_corrector(uint64_t pc, prediction_state& state);
+
+  void update_tage(const prediction_state& state, bool taken);
+  void update_loop(uint64_t pc, const prediction_state& state, bool taken);
+  void update_corrector(const prediction_state& state, bool taken);
+  void push_path(uint64_t pc);
+};
+
+class tage_sc_l : public basic_tage_sc_l<0>
+{
+public:
+  using basic_tage_sc_l::basic_tage_sc_l;
+};
+
+template <int LOG_SCALE>
+constexpr std::size_t basic_tage_sc_l<LOG_SCALE>::storage_bits()
+{
+  std::size_t bits = (std::size_t{1} << LOG_BIMODAL_ENTRIES) * 2;
+  for (auto tag_bits : TAG_BITS)
+    bits += TAGGED_ENTRIES * (tag_bits + 1 + COUNTER_BITS + USEFUL_BITS);
+  bits += LOOP_SETS * LOOP_WAYS * (LOOP_TAG_BITS + 2 * LOOP_ITERATION_BITS + 2 + 3 + 1 + 1);
+  bits += NUM_SC_TABLES * SC_ENTRIES * SC_COUNTER_BITS;
+  bits += HISTORY_LENGTHS.back() + PATH_HISTORY_BITS;
+  bits += 4 + 7 + 8 + 6 + 18; // the adaptive counters
+  return bits;
+}
+
+#endif
@@ -44,6 +44,7 @@ core_builder_parts = {
     'sq_width': '.sq_width(champsim::bandwidth::maximum_type{{{sq_width}}})',
     'retire_width': '.retire_width(champsim::bandwidth::maximum_type{{{retire_width}}})',
     'mispredict_penalty': '.mispredict_penalty({mispredict_penalty})',
+    'branch_resolution': '.branch_resolution(champsim::branch_resolution_stage::{branch_resolution})',
     'decode_latency': '.decode_latency({decode_latency})',
     'dispatch_latency': '.dispatch_latency({dispatch_latency})',
     'schedule_latency': '.schedule_latency({schedule_latency})',
@@ -64,6 +64,15 @@ def relroot(abspath):
     champsim_root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
     return os.path.relpath(abspath, start=champsim_root)
 
+def bpsim_executable(executable_basename):
+    '''
+    The name of the branch predictor replay driver built alongside an executable.
+    A leading "champsim" is replaced with "bpsim", and other names have "_bpsim" appended.
+    '''
+    if executable_basename.startswith('champsim'):
+        return 'bpsim' + executable_basename[len('champsim'):]
+    return executable_basename + '_bpsim'
+
 def get_makefile_lines(build_id, executable, module_info):
     ''' Generate all of the lines to be written in a particular configuration's makefile '''
     yield from header({
@@ -73,9 +82,10 @@ def get_makefile_lines(build_id, executable, module_info):
     })
     yield ''
     exe_dirname, exe_basename = os.path.split(os.path.normpath(executable))
+    bpsim_basename = os.path.join('$(BIN_ROOT)', bpsim_executable(exe_basename))
     exe_basename = os.path.join('$(BIN_ROOT)', exe_basename)
     yield from hard_assign_variable('BIN_ROOT', exe_dirname)
-    yield from hard_assign_variable('build_id', build_id, targets=[exe_basename])
+    yield from hard_assign_variable('build_id', build_id, targets=[exe_basename, bpsim_basename])
 
     mod_paths = [relroot(mod["path"]) for mod in module_info.values()]
     yield from append_variable('nonbase_module_objs', '$(filter-out $(base_module_objs),$(call get_module_list,', *mod_paths, '))')
@@ -85,5 +95,6 @@ def get_makefile_lines(build_id, executable, module_info):
         yield from append_variable('prereq_for_generated', *legacy_paths, targets=['$(generated_files)'])
 
     yield from append_variable('executable_name', exe_basename)
+    yield from append_variable('bpsim_name', bpsim_basename)
 
     yield ''
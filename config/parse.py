@@ -233,7 +233,7 @@ class NormalizedConfiguration:
             (
                 'frequency', 'ifetch_buffer_size', 'decode_buffer_size', 'dispatch_buffer_size', 'register_file_size', 'rob_size', 'lq_size',
                 'sq_size', 'fetch_width', 'decode_width', 'dispatch_width', 'execute_width', 'lq_width', 'sq_width',
-                'retire_width', 'mispredict_penalty', 'scheduler_size', 'decode_latency', 'dispatch_latency',
+                'retire_width', 'mispredict_penalty', 'branch_resolution', 'scheduler_size', 'decode_latency', 'dispatch_latency',
                 'schedule_latency', 'execute_latency', 'branch_predictor', 'btb', 'DIB'
             )
         )
@@ -0,0 +1,121 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATCH_RING_H
+#define BATCH_RING_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * A bounded ring of immutable batches, written by one producer and read in full by each of a fixed number of consumers.
+ *
+ * Every consumer sees every batch, in order. A batch is shared between the consumers rather than copied, and its slot is reused
+ * only after every consumer has taken it, so the producer blocks when the slowest consumer is a full ring behind. A consumer that
+ * stops early must leave() the ring, or the producer may wait for it forever.
+ */
+template <typename T>
+class batch_ring
+{
+  static constexpr uint64_t departed = std::numeric_limits<uint64_t>::max();
+
+  std::mutex mutex;
+  std::condition_variable space_available;
+  std::condition_variable batch_available;
+
+  std::vector<std::shared_ptr<const T>> slots;
+  std::vector<uint64_t> taken; // The number of batches each consumer has taken
+  uint64_t produced = 0;
+  bool closed = false;
+
+  [[nodiscard]] bool has_space() const
+  {
+    auto slowest = *std::min_element(std::begin(taken), std::end(taken));
+    return slowest == departed || produced - slowest < std::size(slots);
+  }
+
+public:
+  batch_ring(std::size_t capacity, std::size_t consumers) : slots(std::max<std::size_t>(capacity, 1)), taken(std::max<std::size_t>(consumers, 1)) {}
+
+  /**
+   * Add a batch to the ring, waiting until there is room for it
+   */
+  void push(T batch)
+  {
+    auto shared = std::make_shared<const T>(std::move(batch));
+    {
+      std::unique_lock lock{mutex};
+      space_available.wait(lock, [this] { return has_space(); });
+      slots[produced % std::size(slots)] = std::move(shared);
+      ++produced;
+    }
+    batch_available.notify_all();
+  }
+
+  /**
+   * Mark that no more batches will be added
+   */
+  void close()
+  {
+    {
+      std::lock_guard lock{mutex};
+      closed = true;
+    }
+    batch_available.notify_all();
+  }
+
+  /**
+   * Take the consumer's next batch, waiting until it is available. Returns a null pointer once the ring is closed and the consumer
+   * has taken every batch.
+   */
+  std::shared_ptr<const T> pop(std::size_t consumer)
+  {
+    std::shared_ptr<const T> result;
+    {
+      std::unique_lock lock{mutex};
+      batch_available.wait(lock, [this, consumer] { return closed || taken.at(consumer) < produced; });
+      if (taken.at(consumer) >= produced) {
+        return nullptr;
+      }
+      result = slots[taken.at(consumer) % std::size(slots)];
+      ++taken.at(consumer);
+    }
+    space_available.notify_one();
+    return result;
+  }
+
+  /**
+   * Mark that the consumer will take no more batches
+   */
+  void leave(std::size_t consumer)
+  {
+    {
+      std::lock_guard lock{mutex};
+      taken.at(consumer) = departed;
+    }
+    space_available.notify_one();
+  }
+};
+} // namespace champsim
+
+#endif
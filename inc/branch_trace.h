@@ -0,0 +1,182 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BRANCH_TRACE_H
+#define BRANCH_TRACE_H
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "address.h"
+#include "instruction.h"
+
+namespace champsim
+{
+/**
+ * One branch in a branch trace.
+ */
+struct branch_record {
+  champsim::address ip{};
+  champsim::address target{}; // Zero unless the branch was taken, as for ooo_model_instr::branch_target
+  uint64_t instructions = 1;  // The number of instructions since the previous branch, including this one
+  branch_type type = BRANCH_OTHER;
+  bool taken = false;
+
+  [[nodiscard]] bool operator==(const branch_record& other) const
+  {
+    return ip == other.ip && target == other.target && instructions == other.instructions && type == other.type && taken == other.taken;
+  }
+  [[nodiscard]] bool operator!=(const branch_record& other) const { return !(*this == other); }
+};
+
+/**
+ * The layout of a branch trace file.
+ *
+ * A branch trace holds only the branches of a full trace. It begins with a header that gives the magic string, the format version,
+ * and the number of instructions and branches in the whole trace. It is followed by a sequence of blocks, each of which is a block
+ * header and then a zlib-compressed payload. Every block can be decoded on its own.
+ *
+ * In the payload, each branch is a flags byte (the branch type in the low three bits and the direction in the fourth), then
+ * LEB128 varints for the zigzag-encoded difference from the previous branch's IP, and the number of instructions since the
+ * previous branch. A taken branch is followed by the zigzag-encoded difference of its target from its IP. The previous IP is zero
+ * at the start of each block.
+ */
+namespace branch_trace_format
+{
+constexpr std::array<char, 8> MAGIC{{'C', 'H', 'B', 'R', 'T', 'R', 'C', '\0'}};
+constexpr uint32_t VERSION = 1;
+constexpr std::size_t DEFAULT_BLOCK_RECORDS = 1 << 16;
+
+constexpr uint8_t TYPE_MASK = 0x7;
+constexpr uint8_t TAKEN_BIT = 0x8;
+
+struct header {
+  std::array<char, 8> magic = MAGIC;
+  uint32_t version = VERSION;
+  uint32_t reserved = 0;
+  uint64_t instructions = 0;
+  uint64_t branches = 0;
+};
+
+struct block_header {
+  uint32_t compressed_size = 0;
+  uint32_t raw_size = 0;
+  uint32_t records = 0;
+  uint32_t reserved = 0;
+  uint64_t instructions = 0;
+};
+
+/**
+ * Append the encoding of the branch to the payload, relative to the previous IP.
+ */
+void encode(std::vector<uint8_t>& payload, const branch_record& record, uint64_t previous_ip);
+
+/**
+ * Decode the branch at the given position of the payload, relative to the previous IP, and advance the position.
+ */
+branch_record decode(const std::vector<uint8_t>& payload, std::size_t& position, uint64_t previous_ip);
+} // namespace branch_trace_format
+
+/**
+ * Writes a branch trace.
+ *
+ * Every instruction of the full trace is passed to the writer, so that the instruction counts are kept, but only the branches are
+ * stored. The header is completed when the writer is closed or destroyed.
+ */
+class branch_tracewriter
+{
+  std::ofstream file;
+  std::size_t block_records;
+  branch_trace_format::header totals{};
+  branch_trace_format::block_header block{};
+  std::vector<uint8_t> payload;
+  uint64_t previous_ip = 0;
+  uint64_t pending_instructions = 0;
+
+  void flush();
+
+public:
+  explicit branch_tracewriter(const std::string& file_name, std::size_t records_per_block = branch_trace_format::DEFAULT_BLOCK_RECORDS);
+  branch_tracewriter(const branch_tracewriter&) = delete;
+  branch_tracewriter& operator=(const branch_tracewriter&) = delete;
+  ~branch_tracewriter();
+
+  void operator()(const ooo_model_instr& instr);
+  void operator()(const branch_record& record);
+
+  /**
+   * Write the remaining branches and complete the header. Instructions after the last branch are counted in the header only.
+   */
+  void close();
+};
+
+/**
+ * Reads a branch trace.
+ *
+ * Branches are decoded a block at a time. They can be read one at a time, or a whole block can be taken at once with next_block().
+ */
+class branch_tracereader
+{
+  std::ifstream file;
+  branch_trace_format::header header_{};
+  std::vector<uint8_t> compressed;
+  std::vector<uint8_t> payload;
+  std::vector<branch_record> buffer;
+  std::size_t buffer_position = 0;
+  uint64_t branches_returned = 0;
+
+  bool read_block(std::vector<branch_record>& records);
+
+public:
+  explicit branch_tracereader(const std::string& file_name);
+
+  /**
+   * Whether the file begins with the magic string of a branch trace
+   */
+  static bool is_branch_trace(const std::string& file_name);
+
+  /**
+   * The number of instructions and branches in the whole trace
+   */
+  [[nodiscard]] uint64_t instructions() const { return header_.instructions; }
+  [[nodiscard]] uint64_t branches() const { return header_.branches; }
+
+  /**
+   * Replace the contents of the vector with the next block of branches. Returns false if there are none left.
+   * Branches that were decoded but not yet returned by operator() are returned first.
+   */
+  bool next_block(std::vector<branch_record>& records);
+
+  branch_record operator()();
+
+  [[nodiscard]] bool eof() const { return branches_returned == header_.branches; }
+};
+
+/**
+ * Make a record of the instruction, which accounts for the given number of instructions of the full trace.
+ */
+branch_record make_record(const ooo_model_instr& instr, uint64_t instructions = 1);
+
+/**
+ * Make a model instruction for the branch, as it would have been read from the full trace.
+ */
+ooo_model_instr make_instr(uint8_t cpu, const branch_record& record);
+} // namespace champsim
+
+#endif
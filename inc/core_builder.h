@@ -27,6 +27,16 @@ class O3_CPU;
 namespace champsim
 {
 class channel;
+
+/**
+ * The stage at which the branch direction predictor learns the outcome of a branch.
+ */
+enum class branch_resolution_stage {
+  fetch,   // immediately after the prediction, with the outcome from the trace
+  execute, // when the branch completes execution
+  retire   // when the branch retires
+};
+
 template <typename...>
 class core_builder_module_type_holder
 {
@@ -63,6 +73,7 @@ struct core_builder_base {
   unsigned m_dib_hit_latency{};
 
   unsigned m_mispredict_penalty{};
+  branch_resolution_stage m_branch_resolution{branch_resolution_stage::fetch};
   unsigned m_decode_latency{};
   unsigned m_dispatch_latency{};
   unsigned m_schedule_latency{};
@@ -205,6 +216,12 @@ public:
    */
   self_type& mispredict_penalty(unsigned mispredict_penalty_);
 
+  /**
+   * Specify when the branch direction predictor is told the outcome of each branch.
+   * Resolving later than fetch makes the predictor work without the outcomes of the branches in flight.
+   */
+  self_type& branch_resolution(branch_resolution_stage branch_resolution_);
+
   /**
    * Specify the latency of the decode.
    */
@@ -430,6 +447,13 @@ auto champsim::core_builder<B, T>::mispredict_penalty(unsigned mispredict_penalt
   return *this;
 }
 
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::branch_resolution(branch_resolution_stage branch_resolution_) -> self_type&
+{
+  m_branch_resolution = branch_resolution_;
+  return *this;
+}
+
 template <typename B, typename T>
 auto champsim::core_builder<B, T>::decode_latency(unsigned decode_latency_) -> self_type&
 {
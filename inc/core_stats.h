@@ -1,12 +1,57 @@
 #ifndef CORE_STATS_H
 #define CORE_STATS_H
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "event_counter.h"
 #include "instruction.h"
 
+/**
+ * Telemetry reported by a meta predictor, which chooses between several arms for each branch.
+ *
+ * An arm's prediction is only counted as correct or incorrect on branches where the arm was
+ * evaluated. The regret is the number of branches the predictor got wrong beyond what the best
+ * single arm for each bucket would have got wrong, measured over the regret_branches on which
+ * every arm was evaluated. A bucket's convergence time is the number of branches it saw before
+ * it settled on one arm, and bin i of the histogram counts times in [2^(i-1), 2^i).
+ *
+ * In the oracle training mode, the chooser's correct predictions are counted next to those of
+ * the per-branch oracle, which is correct if any arm is, and of the best fixed arm for each
+ * bucket. The regret and the best fixed arm are maxima, so they are measured from the start of
+ * the phase rather than accumulated, and are zero in the report taken at its start.
+ *
+ * In the gated training mode, gated_evaluations counts the arm predictions made over the
+ * gated_branches, of which gate_probes evaluated every arm to re-check the gated ones. An arm is
+ * counted in arms_gated each time a bucket stops evaluating it, and in arms_reopened each time
+ * a bucket starts again.
+ */
+struct meta_predictor_stats {
+  static constexpr std::size_t CONVERGENCE_BINS = 16;
+
+  std::vector<uint64_t> arm_selections = {};
+  std::vector<uint64_t> arm_correct = {};
+  std::vector<uint64_t> arm_incorrect = {};
+  int64_t regret = 0;
+  uint64_t regret_branches = 0;
+  std::array<uint64_t, CONVERGENCE_BINS> convergence_times = {};
+  uint64_t unconverged = 0; // buckets in use that have not converged, at the time of the report
+  uint64_t oracle_branches = 0;
+  uint64_t chooser_correct = 0;
+  uint64_t oracle_correct = 0;
+  uint64_t static_best_correct = 0;
+  uint64_t gated_branches = 0;
+  uint64_t gated_evaluations = 0;
+  uint64_t gate_probes = 0;
+  uint64_t arms_gated = 0;
+  uint64_t arms_reopened = 0;
+};
+
+meta_predictor_stats operator-(meta_predictor_stats lhs, const meta_predictor_stats& rhs);
+
 struct cpu_stats {
   std::string name;
   long long begin_instrs = 0;
@@ -18,6 +63,10 @@ struct cpu_stats {
   champsim::stats::event_counter<branch_type> total_branch_types = {};
   champsim::stats::event_counter<branch_type> branch_type_misses = {};
 
+  meta_predictor_stats meta_predictor = {};
+
+  std::size_t branch_predictor_storage_bits = 0; // the size of the branch predictor, which does not change between phases
+
   [[nodiscard]] auto instrs() const { return end_instrs - begin_instrs; }
   [[nodiscard]] auto cycles() const { return end_cycles - begin_cycles; }
 };
@@ -17,6 +17,7 @@
 #ifndef MODULES_H
 #define MODULES_H
 
+#include <cstddef>
 #include <cstdint>
 #include <type_traits>
 #include <utility>
@@ -46,6 +47,29 @@ struct bound_to {
 struct branch_predictor : public bound_to<O3_CPU> {
   explicit branch_predictor(O3_CPU* cpu) : bound_to<O3_CPU>(cpu) {}
 
+  // Identifies a prediction when the branch is resolved. A predictor that keeps state for each prediction until its branch is resolved takes
+  // one as the first argument of predict_branch() and last_branch_result(), since branches may be resolved some time after they are predicted.
+  using prediction_id = uint64_t;
+
+  // Predictors keep their state for this many of the most recent predictions. A branch resolved after this many more predictions, one for each
+  // instruction, has lost it. This is enough for every instruction in flight when branches are resolved at retire.
+  constexpr static std::size_t MAX_PREDICTIONS_IN_FLIGHT = 1024;
+
+  // A predictor that updates its history speculatively, as branches are predicted, may take repair_branch_history(), with the arguments of
+  // last_branch_result(). It is called when a branch is found to be mispredicted, before any branch on the correct path is predicted.
+
+  // A predictor whose tables can be resized takes the log2 of the factor to resize them by, in this range, as a template parameter
+  constexpr static int MIN_LOG_SCALE = -4;
+  constexpr static int MAX_LOG_SCALE = 2;
+
+  // The size of a table of the given default size, resized by the given scale, and never empty
+  [[nodiscard]] constexpr static std::size_t scale_size(std::size_t size, int log_scale)
+  {
+    if (log_scale >= 0)
+      return size << log_scale;
+    return (size >> -log_scale) > 0 ? (size >> -log_scale) : 1;
+  }
+
   template <typename T, typename... Args>
   static auto initialize_member_impl(int) -> decltype(std::declval<T>().initialize_branch_predictor(std::declval<Args>()...), std::true_type{});
   template <typename, typename...>
@@ -61,6 +85,36 @@ struct branch_predictor : public bound_to<O3_CPU> {
   template <typename, typename...>
   static auto predict_branch_member_impl(long) -> std::false_type;
 
+  template <typename T, typename... Args>
+  static auto repair_member_impl(int) -> decltype(std::declval<T>().repair_branch_history(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto repair_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto snapshot_member_impl(int) -> decltype(std::declval<T>().snapshot_branch_predictor(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto snapshot_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto telemetry_member_impl(int) -> decltype(std::declval<T>().meta_predictor_telemetry(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto telemetry_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto begin_phase_member_impl(int) -> decltype(std::declval<T>().begin_phase_branch_predictor(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto begin_phase_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto final_stats_member_impl(int) -> decltype(std::declval<T>().branch_predictor_final_stats(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto final_stats_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto storage_bits_member_impl(int) -> decltype(std::declval<T>().storage_bits(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto storage_bits_member_impl(long) -> std::false_type;
+
   template <typename T, typename... Args>
   constexpr static bool has_initialize = decltype(initialize_member_impl<T, Args...>(0))::value;
 
@@ -69,6 +123,24 @@ struct branch_predictor : public bound_to<O3_CPU> {
 
   template <typename T, typename... Args>
   constexpr static bool has_predict_branch = decltype(predict_branch_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_repair_branch_history = decltype(repair_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_snapshot = decltype(snapshot_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_telemetry = decltype(telemetry_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_begin_phase = decltype(begin_phase_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_final_stats = decltype(final_stats_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_storage_bits = decltype(storage_bits_member_impl<T, Args...>(0))::value;
 };
 
 struct btb : public bound_to<O3_CPU> {
@@ -0,0 +1,100 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MSL_PACKED_COUNTER_ARRAY_H
+#define MSL_PACKED_COUNTER_ARRAY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace champsim::msl
+{
+/**
+ * An array of unsigned saturating counters, packed into 64-bit words.
+ *
+ * Each counter behaves as a fwcounter<WIDTH>, from zero to a maximum of 2^WIDTH - 1, and starts at zero. A table of fwcounter
+ * takes eight bytes per counter, so a table of 2-bit counters packed this way is 32 times smaller. Incrementing and decrementing
+ * are branch-free.
+ *
+ * \tparam WIDTH The width of each counter, in bits. No counter straddles two words, so if the width does not divide 64, the top bits
+ * of each word are unused.
+ * \tparam SIZE The number of counters.
+ */
+template <std::size_t WIDTH, std::size_t SIZE>
+class packed_counter_array
+{
+  static_assert(WIDTH > 0 && WIDTH < 64, "The counters must fit in a word");
+
+  using word_type = uint64_t;
+  constexpr static std::size_t COUNTERS_PER_WORD = 64 / WIDTH;
+  constexpr static word_type MASK = (word_type{1} << WIDTH) - 1;
+
+  std::array<word_type, (SIZE + COUNTERS_PER_WORD - 1) / COUNTERS_PER_WORD> words = {};
+
+  constexpr static std::size_t shift(std::size_t index) { return (index % COUNTERS_PER_WORD) * WIDTH; }
+
+public:
+  using value_type = unsigned;
+  constexpr static value_type minimum = 0;
+  constexpr static value_type maximum = static_cast<value_type>(MASK);
+
+  [[nodiscard]] value_type operator[](std::size_t index) const { return static_cast<value_type>((words[index / COUNTERS_PER_WORD] >> shift(index)) & MASK); }
+
+  /**
+   * How far a counter value is from the middle of the range, from 0 for the two values either side of the middle to 1 at either end.
+   */
+  [[nodiscard]] constexpr static float strength(value_type value)
+  {
+    static_assert(WIDTH > 1, "A 1-bit counter has no strength");
+    const auto distance = (2 * value > maximum) ? (2 * value - maximum) : (maximum - 2 * value);
+    return static_cast<float>(distance - 1) / static_cast<float>(maximum - 1);
+  }
+
+  /**
+   * Increment the counter, saturating at the maximum value.
+   */
+  void increment(std::size_t index)
+  {
+    auto& word = words[index / COUNTERS_PER_WORD];
+    word += word_type{((word >> shift(index)) & MASK) != MASK} << shift(index);
+  }
+
+  /**
+   * Decrement the counter, saturating at zero.
+   */
+  void decrement(std::size_t index)
+  {
+    auto& word = words[index / COUNTERS_PER_WORD];
+    word -= word_type{((word >> shift(index)) & MASK) != 0} << shift(index);
+  }
+
+  /**
+   * Increment the counter if the condition is true, else decrement it.
+   */
+  void update(std::size_t index, bool up)
+  {
+    if (up)
+      increment(index);
+    else
+      decrement(index);
+  }
+
+  [[nodiscard]] constexpr static std::size_t size() { return SIZE; }
+};
+} // namespace champsim::msl
+
+#endif
@@ -0,0 +1,113 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MSL_SEQUENCE_RING_H
+#define MSL_SEQUENCE_RING_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace champsim::msl
+{
+/**
+ * A fixed-capacity ring of in-flight state, such as the state a branch predictor keeps from a prediction until its branch is
+ * resolved.
+ *
+ * Each entry is tagged with the sequence number it was pushed with, and is found again by that number in constant time. Once
+ * CAPACITY newer entries have been pushed, an entry is overwritten, and looking it up fails rather than finding the wrong state.
+ *
+ * \tparam T The type of the state. It is default-constructed to fill the ring.
+ * \tparam CAPACITY The number of entries. It must be a power of two.
+ */
+template <typename T, std::size_t CAPACITY>
+class sequence_ring
+{
+  static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "The capacity must be a power of two");
+
+public:
+  using value_type = T;
+  using sequence_type = uint64_t;
+  constexpr static sequence_type INVALID = std::numeric_limits<sequence_type>::max();
+
+private:
+  struct entry_type {
+    sequence_type sequence = INVALID;
+    value_type value{};
+  };
+
+  std::array<entry_type, CAPACITY> entries{};
+  sequence_type next_sequence = 0;
+
+  constexpr static std::size_t slot(sequence_type sequence) { return static_cast<std::size_t>(sequence & (CAPACITY - 1)); }
+
+public:
+  /**
+   * Add an entry, overwriting the oldest if the ring is full, and return its sequence number.
+   */
+  sequence_type push(const value_type& value)
+  {
+    auto sequence = next_sequence++;
+    entries[slot(sequence)] = entry_type{sequence, value};
+    return sequence;
+  }
+
+  /**
+   * Add an entry with a sequence number chosen by the caller, such as the identifier of a prediction, overwriting whichever entry shares its
+   * slot. The sequence numbers given should increase, so that this entry overwrites older ones.
+   */
+  void push(sequence_type sequence, const value_type& value)
+  {
+    next_sequence = sequence + 1;
+    entries[slot(sequence)] = entry_type{sequence, value};
+  }
+
+  /**
+   * Find the entry with the given sequence number, or nullptr if it has been erased or overwritten.
+   */
+  value_type* find(sequence_type sequence)
+  {
+    auto& entry = entries[slot(sequence)];
+    return (entry.sequence == sequence) ? &entry.value : nullptr;
+  }
+
+  const value_type* find(sequence_type sequence) const
+  {
+    const auto& entry = entries[slot(sequence)];
+    return (entry.sequence == sequence) ? &entry.value : nullptr;
+  }
+
+  /**
+   * Remove the entry with the given sequence number, if it is still present.
+   */
+  void erase(sequence_type sequence)
+  {
+    auto& entry = entries[slot(sequence)];
+    if (entry.sequence == sequence)
+      entry.sequence = INVALID;
+  }
+
+  /**
+   * The sequence number of the most recent push, or INVALID if there has been none.
+   */
+  [[nodiscard]] sequence_type last() const { return next_sequence - 1; }
+
+  constexpr static std::size_t capacity() { return CAPACITY; }
+};
+} // namespace champsim::msl
+
+#endif
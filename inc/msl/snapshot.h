@@ -0,0 +1,209 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MSL_SNAPSHOT_H
+#define MSL_SNAPSHOT_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace champsim::msl
+{
+/**
+ * The layout of a snapshot file.
+ *
+ * A snapshot begins with a header that holds a magic string and the format version. It is
+ * followed by one section per table, in the order the tables were written. Each section is
+ * an 8-byte length, then the raw bytes of the table, starting on an ALIGNMENT-byte boundary so
+ * that a table in a mapped file is as aligned as it would be in memory.
+ *
+ * The file records no types or names. A snapshot can only be restored into a model built with
+ * the same configuration, and a table whose size does not match is reported as an error.
+ */
+namespace snapshot_format
+{
+constexpr std::array<char, 8> MAGIC{{'C', 'H', 'S', 'N', 'A', 'P', '\0', '\0'}};
+constexpr uint32_t VERSION = 1;
+constexpr std::size_t ALIGNMENT = 64;
+
+struct header {
+  std::array<char, 8> magic = MAGIC;
+  uint32_t version = VERSION;
+  uint32_t reserved = 0;
+};
+
+constexpr std::size_t align(std::size_t offset) { return (offset + ALIGNMENT - 1) & ~(ALIGNMENT - 1); }
+
+template <typename T>
+constexpr void check_table_type()
+{
+  static_assert(std::is_trivially_copyable_v<T>, "Snapshot tables must be trivially copyable");
+}
+} // namespace snapshot_format
+
+/**
+ * Writes tables to a snapshot file.
+ *
+ * Each call writes one table as one section. A table is any trivially copyable object (such as
+ * a std::array of counters), or a std::vector of trivially copyable elements.
+ */
+class snapshot_writer
+{
+  std::ofstream file;
+  std::size_t offset = 0;
+
+  void write_section(const void* data, std::size_t size)
+  {
+    const uint64_t length = size;
+    write_raw(&length, sizeof(length));
+
+    const std::array<char, snapshot_format::ALIGNMENT> padding{};
+    write_raw(padding.data(), snapshot_format::align(offset) - offset);
+    write_raw(data, size);
+  }
+
+  void write_raw(const void* data, std::size_t size)
+  {
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    offset += size;
+  }
+
+public:
+  explicit snapshot_writer(const std::string& file_name) : file(file_name, std::ios::binary | std::ios::trunc)
+  {
+    if (!file)
+      throw std::runtime_error{"Could not open snapshot file " + file_name + " for writing"};
+    const snapshot_format::header header{};
+    write_raw(&header, sizeof(header));
+  }
+
+  template <typename T>
+  void operator()(const T& table)
+  {
+    snapshot_format::check_table_type<T>();
+    write_section(&table, sizeof(T));
+  }
+
+  template <typename T>
+  void operator()(const std::vector<T>& table)
+  {
+    snapshot_format::check_table_type<T>();
+    write_section(std::data(table), std::size(table) * sizeof(T));
+  }
+};
+
+/**
+ * Restores tables from a snapshot file.
+ *
+ * The file is mapped into memory, and each table is restored with a single memcpy from its
+ * section. The tables must be read in the order they were written.
+ */
+class snapshot_reader
+{
+  const char* begin = nullptr;
+  std::size_t length = 0;
+  std::size_t offset = 0;
+
+  const char* read_section(std::size_t expected_size)
+  {
+    uint64_t size = 0;
+    if (offset + sizeof(size) > length)
+      throw std::runtime_error{"Snapshot file ended before all tables were restored"};
+    std::memcpy(&size, begin + offset, sizeof(size));
+    offset = snapshot_format::align(offset + sizeof(size));
+
+    if (size != expected_size)
+      throw std::runtime_error{"Snapshot table is " + std::to_string(size) + " bytes, but " + std::to_string(expected_size)
+                               + " were expected. Was it written with a different configuration?"};
+    if (offset + size > length)
+      throw std::runtime_error{"Snapshot file ended before all tables were restored"};
+
+    const char* section = begin + offset;
+    offset += size;
+    return section;
+  }
+
+public:
+  explicit snapshot_reader(const std::string& file_name)
+  {
+    int fd = ::open(file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+      throw std::runtime_error{"Could not open snapshot file " + file_name};
+
+    struct stat file_stat {
+    };
+    if (::fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(sizeof(snapshot_format::header))) {
+      ::close(fd);
+      throw std::runtime_error{"Snapshot file " + file_name + " is too short"};
+    }
+
+    length = static_cast<std::size_t>(file_stat.st_size);
+    void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) // NOLINT(cppcoreguidelines-pro-type-cstyle-cast): MAP_FAILED is a macro
+      throw std::runtime_error{"Could not map snapshot file " + file_name};
+    begin = static_cast<const char*>(mapping);
+
+    snapshot_format::header header{};
+    std::memcpy(&header, begin, sizeof(header));
+    offset = sizeof(header);
+    if (header.magic != snapshot_format::MAGIC || header.version != snapshot_format::VERSION) {
+      ::munmap(const_cast<char*>(begin), length); // NOLINT(cppcoreguidelines-pro-type-const-cast): munmap takes a non-const pointer
+      throw std::runtime_error{"Snapshot file " + file_name + " is not a version " + std::to_string(snapshot_format::VERSION) + " snapshot"};
+    }
+  }
+
+  snapshot_reader(const snapshot_reader&) = delete;
+  snapshot_reader& operator=(const snapshot_reader&) = delete;
+
+  ~snapshot_reader()
+  {
+    ::munmap(const_cast<char*>(begin), length); // NOLINT(cppcoreguidelines-pro-type-const-cast): munmap takes a non-const pointer
+  }
+
+  template <typename T>
+  void operator()(T& table)
+  {
+    snapshot_format::check_table_type<T>();
+    std::memcpy(&table, read_section(sizeof(T)), sizeof(T));
+  }
+
+  template <typename T>
+  void operator()(std::vector<T>& table)
+  {
+    snapshot_format::check_table_type<T>();
+    std::memcpy(std::data(table), read_section(std::size(table) * sizeof(T)), std::size(table) * sizeof(T));
+  }
+
+  /**
+   * Whether every table in the file has been restored
+   */
+  [[nodiscard]] bool done() const { return offset == length; }
+};
+} // namespace champsim::msl
+
+#endif
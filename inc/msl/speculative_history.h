@@ -0,0 +1,155 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MSL_SPECULATIVE_HISTORY_H
+#define MSL_SPECULATIVE_HISTORY_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+namespace champsim::msl
+{
+/**
+ * A global history of branch outcomes that is updated speculatively, with each prediction, and repaired when a branch turns out to
+ * have been mispredicted.
+ *
+ * The history is read through folded copies of its most recent bits. Each is the XOR of its history taken width bits at a time, as
+ * in the circular shift registers of TAGE, and is updated in constant time with each push, whatever its length.
+ *
+ * The outcomes are kept in a ring longer than the longest folded history, so that a push does not overwrite the bits that a rollback
+ * needs. A checkpoint is then only the position of the newest outcome and the folded values, and rolling back to one undoes every
+ * push since in constant time.
+ *
+ * \tparam RING_BITS The length of the ring. It must be a multiple of 64, and at least the longest folded history plus the number of
+ * outcomes that may be pushed between a checkpoint and its rollback.
+ * \tparam NUM_FOLDS The number of folded copies.
+ */
+template <std::size_t RING_BITS, std::size_t NUM_FOLDS>
+class speculative_history
+{
+  static_assert(RING_BITS > 0 && RING_BITS % 64 == 0, "The ring must be a whole number of words");
+
+public:
+  using folded_type = uint32_t;
+
+  // The number of outcomes in a folded copy, and the number of bits they are folded into
+  struct fold_shape {
+    std::size_t length = 0;
+    std::size_t width = 0;
+  };
+
+  /**
+   * The history before a speculative push, and the outcome that was pushed.
+   */
+  struct checkpoint {
+    uint32_t head = 0;
+    std::array<folded_type, NUM_FOLDS> folded = {};
+    bool outcome = false;
+  };
+
+  speculative_history() = default;
+  explicit speculative_history(const std::array<fold_shape, NUM_FOLDS>& fold_shapes) : shapes(fold_shapes)
+  {
+    for (const auto& shape : shapes) {
+      assert(shape.width > 0 && shape.width < 32);
+      assert(shape.length < RING_BITS);
+    }
+  }
+
+  /**
+   * The outcome pushed the given number of pushes ago, where 0 is the newest.
+   */
+  [[nodiscard]] bool at(std::size_t age) const
+  {
+    const auto position = (head + RING_BITS - age % RING_BITS) % RING_BITS;
+    return ((ring[position / 64] >> (position % 64)) & 1) != 0;
+  }
+
+  /**
+   * The value of the given folded copy.
+   */
+  [[nodiscard]] folded_type folded(std::size_t fold) const { return folds[fold]; }
+
+  /**
+   * Push an outcome that is known to be correct.
+   */
+  void push(bool outcome)
+  {
+    for (std::size_t i = 0; i < NUM_FOLDS; ++i) {
+      const auto [length, width] = shapes[i];
+      if (length == 0)
+        continue;
+
+      // fold in the new outcome, and fold out the one that leaves this history
+      const auto outgoing = folded_type{at(length - 1)};
+      auto value = static_cast<folded_type>((folds[i] << 1) | folded_type{outcome});
+      value ^= static_cast<folded_type>(outgoing << (length % width));
+      value ^= static_cast<folded_type>(value >> width);
+      folds[i] = value & static_cast<folded_type>((folded_type{1} << width) - 1);
+    }
+
+    head = static_cast<uint32_t>((head + 1) % RING_BITS);
+    auto& word = ring[head / 64];
+    word = (word & ~(uint64_t{1} << (head % 64))) | (uint64_t{outcome} << (head % 64));
+  }
+
+  /**
+   * Push a predicted outcome, returning the checkpoint to repair it from.
+   */
+  [[nodiscard]] checkpoint speculate(bool outcome)
+  {
+    checkpoint saved{head, folds, outcome};
+    push(outcome);
+    return saved;
+  }
+
+  /**
+   * If the outcome differs from the one pushed at the checkpoint, roll the history back to the checkpoint and push the outcome instead.
+   * Any outcomes pushed since the checkpoint are discarded, since they followed a misprediction.
+   *
+   * \return Whether the history was repaired.
+   */
+  bool repair(checkpoint& saved, bool outcome)
+  {
+    if (saved.outcome == outcome)
+      return false;
+
+    head = saved.head;
+    folds = saved.folded;
+    push(outcome);
+    saved.outcome = outcome;
+    return true;
+  }
+
+  template <typename Archive>
+  void snapshot(Archive& archive)
+  {
+    archive(ring);
+    archive(head);
+    archive(folds);
+  }
+
+private:
+  std::array<fold_shape, NUM_FOLDS> shapes = {};
+  std::array<uint64_t, RING_BITS / 64> ring = {};
+  uint32_t head = 0;
+  std::array<folded_type, NUM_FOLDS> folds = {};
+};
+} // namespace champsim::msl
+
+#endif
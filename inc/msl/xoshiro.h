@@ -0,0 +1,81 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MSL_XOSHIRO_H
+#define MSL_XOSHIRO_H
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+namespace champsim::msl
+{
+/**
+ * The xoshiro256** pseudorandom generator of Blackman and Vigna.
+ *
+ * The whole state is four 64-bit words, and each draw is a handful of shifts, rotates and
+ * adds, so a model can own its generator instead of sharing the global state behind rand().
+ * Two generators constructed with the same seed produce the same sequence. This type meets
+ * the requirements of UniformRandomBitGenerator, so it can be used with the distributions
+ * in <random>.
+ */
+class xoshiro256starstar
+{
+public:
+  using result_type = uint64_t;
+
+  /**
+   * Seed the generator. The seed is expanded to the full state with splitmix64, so nearby
+   * seeds give unrelated sequences.
+   */
+  explicit constexpr xoshiro256starstar(uint64_t seed = 0) noexcept
+  {
+    for (auto& word : state) {
+      seed += 0x9e3779b97f4a7c15ull;
+      uint64_t z = seed;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      word = z ^ (z >> 31);
+    }
+  }
+
+  static constexpr result_type min() { return std::numeric_limits<result_type>::min(); }
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+  constexpr result_type operator()() noexcept
+  {
+    const uint64_t result = rotl(state[1] * 5, 7) * 9;
+    const uint64_t t = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+
+    return result;
+  }
+
+private:
+  std::array<uint64_t, 4> state{};
+
+  static constexpr uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+} // namespace champsim::msl
+
+#endif
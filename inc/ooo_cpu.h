@@ -40,6 +40,7 @@
 #include "core_stats.h"
 #include "instruction.h"
 #include "modules.h"
+#include "msl/snapshot.h"
 #include "operable.h"
 #include "register_allocator.h"
 #include "util/lru_table.h"
@@ -88,6 +89,7 @@ public:
   // cycle
   champsim::chrono::clock::time_point begin_phase_time{};
   long long begin_phase_instr = 0;
+  meta_predictor_stats begin_phase_meta_predictor_stats{};
   champsim::chrono::clock::time_point finish_phase_time{};
   long long finish_phase_instr = 0;
   champsim::chrono::clock::time_point last_heartbeat_time{};
@@ -131,6 +133,7 @@ public:
   champsim::chrono::clock::duration SCHEDULING_LATENCY;
   champsim::chrono::clock::duration EXEC_LATENCY;
   champsim::chrono::clock::duration DIB_HIT_LATENCY;
+  champsim::branch_resolution_stage BRANCH_RESOLUTION;
 
   champsim::bandwidth::maximum_type L1I_BANDWIDTH, L1D_BANDWIDTH;
 
@@ -138,6 +141,8 @@ public:
 
   // branch
   champsim::chrono::clock::time_point fetch_resume_time{};
+  using branch_prediction_id = champsim::modules::branch_predictor::prediction_id;
+  branch_prediction_id next_branch_prediction_id = 0;
 
   const long IN_QUEUE_SIZE;
   std::deque<ooo_model_instr> input_queue;
@@ -165,6 +170,14 @@ public:
 
   bool do_init_instruction(ooo_model_instr& instr);
   bool do_predict_branch(ooo_model_instr& instr);
+  void do_resolve_branch(const ooo_model_instr& instr);
+  void do_repair_branch_history(const ooo_model_instr& instr);
+
+  /**
+   * Whether a branch, with its direction prediction already recorded, will be redirected at decode or execute.
+   * The predicted target should be empty if the branch was predicted not taken.
+   */
+  [[nodiscard]] static bool is_mispredicted(const ooo_model_instr& instr, champsim::address predicted_target);
   void do_check_dib(ooo_model_instr& instr);
   bool do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end);
   void do_dib_update(const ooo_model_instr& instr);
@@ -191,8 +204,18 @@ public:
     virtual ~branch_module_concept() = default;
 
     virtual void impl_initialize_branch_predictor() = 0;
-    virtual void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) = 0;
-    virtual bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) = 0;
+    virtual void impl_last_branch_result(branch_prediction_id id, champsim::address ip, champsim::address target, bool taken,
+                                         uint8_t branch_type) = 0;
+    virtual bool impl_predict_branch(branch_prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken,
+                                     uint8_t branch_type) = 0;
+    virtual void impl_repair_branch_history(branch_prediction_id id, champsim::address ip, champsim::address target, bool taken,
+                                            uint8_t branch_type) = 0;
+    virtual void impl_save_branch_predictor(champsim::msl::snapshot_writer& writer) = 0;
+    virtual void impl_load_branch_predictor(champsim::msl::snapshot_reader& reader) = 0;
+    virtual meta_predictor_stats impl_meta_predictor_telemetry() = 0;
+    virtual void impl_begin_phase_branch_predictor() = 0;
+    virtual void impl_branch_predictor_final_stats() = 0;
+    virtual std::size_t impl_branch_predictor_storage_bits() = 0;
   };
 
   struct btb_module_concept {
@@ -209,8 +232,16 @@ public:
     explicit branch_module_model(O3_CPU* cpu) : intern_(Bs{cpu}...) { (void)cpu; /* silence -Wunused-but-set-parameter when sizeof...(Bs) == 0 */ }
 
     void impl_initialize_branch_predictor() final;
-    void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) final;
-    [[nodiscard]] bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) final;
+    void impl_last_branch_result(branch_prediction_id id, champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) final;
+    [[nodiscard]] bool impl_predict_branch(branch_prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken,
+                                           uint8_t branch_type) final;
+    void impl_repair_branch_history(branch_prediction_id id, champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) final;
+    void impl_save_branch_predictor(champsim::msl::snapshot_writer& writer) final;
+    void impl_load_branch_predictor(champsim::msl::snapshot_reader& reader) final;
+    [[nodiscard]] meta_predictor_stats impl_meta_predictor_telemetry() final;
+    void impl_begin_phase_branch_predictor() final;
+    void impl_branch_predictor_final_stats() final;
+    [[nodiscard]] std::size_t impl_branch_predictor_storage_bits() final;
   };
 
   template <typename... Ts>
@@ -228,8 +259,16 @@ public:
 
   // NOLINTBEGIN(readability-make-member-function-const): legacy modules use non-const hooks
   void impl_initialize_branch_predictor() const;
-  void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const;
-  [[nodiscard]] bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) const;
+  void impl_last_branch_result(branch_prediction_id id, champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const;
+  [[nodiscard]] bool impl_predict_branch(branch_prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken,
+                                         uint8_t branch_type) const;
+  void impl_repair_branch_history(branch_prediction_id id, champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const;
+  void impl_save_branch_predictor(champsim::msl::snapshot_writer& writer) const;
+  void impl_load_branch_predictor(champsim::msl::snapshot_reader& reader) const;
+  [[nodiscard]] meta_predictor_stats impl_meta_predictor_telemetry() const;
+  void impl_begin_phase_branch_predictor() const;
+  void impl_branch_predictor_final_stats() const;
+  [[nodiscard]] std::size_t impl_branch_predictor_storage_bits() const;
 
   void impl_initialize_btb() const;
   void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) const;
@@ -246,9 +285,10 @@ public:
         EXEC_WIDTH(b.m_execute_width), DIB_INORDER_WIDTH(b.m_dib_inorder_width), LQ_WIDTH(b.m_lq_width), SQ_WIDTH(b.m_sq_width), RETIRE_WIDTH(b.m_retire_width),
         BRANCH_MISPREDICT_PENALTY(b.m_mispredict_penalty * b.m_clock_period), DISPATCH_LATENCY(b.m_dispatch_latency * b.m_clock_period),
         DECODE_LATENCY(b.m_decode_latency * b.m_clock_period), SCHEDULING_LATENCY(b.m_schedule_latency * b.m_clock_period),
-        EXEC_LATENCY(b.m_execute_latency * b.m_clock_period), DIB_HIT_LATENCY(b.m_dib_hit_latency * b.m_clock_period), L1I_BANDWIDTH(b.m_l1i_bw),
-        L1D_BANDWIDTH(b.m_l1d_bw), IN_QUEUE_SIZE(2 * champsim::to_underlying(b.m_fetch_width)), L1I_bus(b.m_cpu, b.m_fetch_queues),
-        L1D_bus(b.m_cpu, b.m_data_queues), l1i(b.m_l1i), branch_module_pimpl(std::make_unique<branch_module_model<Bs...>>(this)),
+        EXEC_LATENCY(b.m_execute_latency * b.m_clock_period), DIB_HIT_LATENCY(b.m_dib_hit_latency * b.m_clock_period),
+        BRANCH_RESOLUTION(b.m_branch_resolution), L1I_BANDWIDTH(b.m_l1i_bw), L1D_BANDWIDTH(b.m_l1d_bw),
+        IN_QUEUE_SIZE(2 * champsim::to_underlying(b.m_fetch_width)), L1I_bus(b.m_cpu, b.m_fetch_queues), L1D_bus(b.m_cpu, b.m_data_queues),
+        l1i(b.m_l1i), branch_module_pimpl(std::make_unique<branch_module_model<Bs...>>(this)),
         btb_module_pimpl(std::make_unique<btb_module_model<Ts...>>(this))
   {
   }
@@ -267,25 +307,40 @@ void O3_CPU::branch_module_model<Bs...>::impl_initialize_branch_predictor()
 }
 
 template <typename... Bs>
-void O3_CPU::branch_module_model<Bs...>::impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type)
+void O3_CPU::branch_module_model<Bs...>::impl_last_branch_result(branch_prediction_id id, champsim::address ip, champsim::address target, bool taken,
+                                                                 uint8_t branch_type)
 {
   [[maybe_unused]] auto process_one = [&](auto& b) {
     using namespace champsim::modules;
-    if constexpr (branch_predictor::has_last_branch_result<decltype(b), uint64_t, uint64_t, bool, uint8_t>)
-      b.last_branch_result(ip.to<uint64_t>(), target.to<uint64_t>(), taken, branch_type);
-    if constexpr (branch_predictor::has_last_branch_result<decltype(b), champsim::address, champsim::address, bool, uint8_t>)
-      b.last_branch_result(ip, target, taken, branch_type);
+    /* Predictors that identify their predictions */
+    if constexpr (branch_predictor::has_last_branch_result<decltype(b), branch_prediction_id, champsim::address, champsim::address, bool, uint8_t>) {
+      b.last_branch_result(id, ip, target, taken, branch_type);
+    } else {
+      if constexpr (branch_predictor::has_last_branch_result<decltype(b), uint64_t, uint64_t, bool, uint8_t>)
+        b.last_branch_result(ip.to<uint64_t>(), target.to<uint64_t>(), taken, branch_type);
+      if constexpr (branch_predictor::has_last_branch_result<decltype(b), champsim::address, champsim::address, bool, uint8_t>)
+        b.last_branch_result(ip, target, taken, branch_type);
+    }
   };
 
   std::apply([&](auto&... b) { (..., process_one(b)); }, intern_);
 }
 
 template <typename... Bs>
-bool O3_CPU::branch_module_model<Bs...>::impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type)
+bool O3_CPU::branch_module_model<Bs...>::impl_predict_branch(branch_prediction_id id, champsim::address ip, champsim::address predicted_target,
+                                                             bool always_taken, uint8_t branch_type)
 {
   using return_type = bool;
   [[maybe_unused]] auto process_one = [&](auto& b) {
     using namespace champsim::modules;
+    /* Predictors that identify their predictions, full size */
+    if constexpr (branch_predictor::has_predict_branch<decltype(b), branch_prediction_id, champsim::address, champsim::address, bool, uint8_t>)
+      return return_type{b.predict_branch(id, ip, predicted_target, always_taken, branch_type)};
+
+    /* Predictors that identify their predictions, short size */
+    if constexpr (branch_predictor::has_predict_branch<decltype(b), branch_prediction_id, champsim::address>)
+      return return_type{b.predict_branch(id, ip)};
+
     /* Strong addresses, full size */
     if constexpr (branch_predictor::has_predict_branch<decltype(b), champsim::address, champsim::address, bool, uint8_t>)
       return return_type{b.predict_branch(ip, predicted_target, always_taken, branch_type)};
@@ -311,6 +366,95 @@ bool O3_CPU::branch_module_model<Bs...>::impl_predict_branch(champsim::address i
   return return_type{};
 }
 
+template <typename... Bs>
+void O3_CPU::branch_module_model<Bs...>::impl_repair_branch_history(branch_prediction_id id, champsim::address ip, champsim::address target,
+                                                                    bool taken, uint8_t branch_type)
+{
+  [[maybe_unused]] auto process_one = [&](auto& b) {
+    using namespace champsim::modules;
+    if constexpr (branch_predictor::has_repair_branch_history<decltype(b), branch_prediction_id, champsim::address, champsim::address, bool, uint8_t>)
+      b.repair_branch_history(id, ip, target, taken, branch_type);
+  };
+
+  std::apply([&](auto&... b) { (..., process_one(b)); }, intern_);
+}
+
+template <typename... Bs>
+void O3_CPU::branch_module_model<Bs...>::impl_save_branch_predictor(champsim::msl::snapshot_writer& writer)
+{
+  [[maybe_unused]] auto process_one = [&](auto& b) {
+    using namespace champsim::modules;
+    if constexpr (branch_predictor::has_snapshot<decltype(b), champsim::msl::snapshot_writer&>)
+      b.snapshot_branch_predictor(writer);
+  };
+
+  std::apply([&](auto&... b) { (..., process_one(b)); }, intern_);
+}
+
+template <typename... Bs>
+void O3_CPU::branch_module_model<Bs...>::impl_load_branch_predictor(champsim::msl::snapshot_reader& reader)
+{
+  [[maybe_unused]] auto process_one = [&](auto& b) {
+    using namespace champsim::modules;
+    if constexpr (branch_predictor::has_snapshot<decltype(b), champsim::msl::snapshot_reader&>)
+      b.snapshot_branch_predictor(reader);
+  };
+
+  std::apply([&](auto&... b) { (..., process_one(b)); }, intern_);
+}
+
+template <typename... Bs>
+meta_predictor_stats O3_CPU::branch_module_model<Bs...>::impl_meta_predictor_telemetry()
+{
+  meta_predictor_stats result{};
+  [[maybe_unused]] auto process_one = [&](auto& b) {
+    using namespace champsim::modules;
+    if constexpr (branch_predictor::has_telemetry<decltype(b)>)
+      result = b.meta_predictor_telemetry();
+  };
+
+  std::apply([&](auto&... b) { (..., process_one(b)); }, intern_);
+  return result;
+}
+
+template <typename... Bs>
+void O3_CPU::branch_module_model<Bs...>::impl_begin_phase_branch_predictor()
+{
+  [[maybe_unused]] auto process_one = [&](auto& b) {
+    using namespace champsim::modules;
+    if constexpr (branch_predictor::has_begin_phase<decltype(b)>)
+      b.begin_phase_branch_predictor();
+  };
+
+  std::apply([&](auto&... b) { (..., process_one(b)); }, intern_);
+}
+
+template <typename... Bs>
+void O3_CPU::branch_module_model<Bs...>::impl_branch_predictor_final_stats()
+{
+  [[maybe_unused]] auto process_one = [&](auto& b) {
+    using namespace champsim::modules;
+    if constexpr (branch_predictor::has_final_stats<decltype(b)>)
+      b.branch_predictor_final_stats();
+  };
+
+  std::apply([&](auto&... b) { (..., process_one(b)); }, intern_);
+}
+
+template <typename... Bs>
+std::size_t O3_CPU::branch_module_model<Bs...>::impl_branch_predictor_storage_bits()
+{
+  std::size_t result = 0;
+  [[maybe_unused]] auto process_one = [&](auto& b) {
+    using namespace champsim::modules;
+    if constexpr (branch_predictor::has_storage_bits<decltype(b)>)
+      result += b.storage_bits();
+  };
+
+  std::apply([&](auto&... b) { (..., process_one(b)); }, intern_);
+  return result;
+}
+
 template <typename... Ts>
 void O3_CPU::btb_module_model<Ts...>::impl_initialize_btb()
 {
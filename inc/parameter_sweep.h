@@ -0,0 +1,98 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PARAMETER_SWEEP_H
+#define PARAMETER_SWEEP_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace champsim::sweep
+{
+/**
+ * The values one parameter may take in a sweep.
+ *
+ * A parameter either takes one of a list of values, or is drawn from a range, uniformly or uniformly in its logarithm. Only lists
+ * can be searched on a grid.
+ */
+struct parameter_space {
+  std::string name;
+  std::vector<double> values;
+  double lower = 0;
+  double upper = 0;
+  bool logarithmic = false;
+  bool integral = false; // Values drawn from the range are rounded to integers
+
+  /**
+   * Parse a list of values ("0.01,0.05,0.1"), a range ("0.01:0.1"), or a logarithmic range ("0.001:0.1:log").
+   */
+  static parameter_space parse(std::string name, std::string_view spec);
+};
+
+using search_space = std::vector<parameter_space>;
+
+// One value for each parameter, in the order of the search space
+using candidate = std::vector<double>;
+
+/**
+ * Every combination of the parameters' values.
+ */
+std::vector<candidate> grid(const search_space& space);
+
+/**
+ * The given number of candidates, drawn independently. A list is drawn from uniformly.
+ */
+std::vector<candidate> sample(const search_space& space, std::size_t count, uint64_t seed);
+
+struct halving_schedule {
+  long long min_instructions = 1'000'000;
+  long long max_instructions = 100'000'000;
+  unsigned reduction = 3; // Each round keeps this fraction of the candidates, and runs them this many times longer
+};
+
+struct result {
+  candidate parameters;
+  unsigned rounds = 0;        // The number of rounds the candidate survived into
+  long long instructions = 0; // The length of the prefix in the last of them
+  double mpki = 0;            // The MPKI over that prefix
+};
+
+/**
+ * Evaluate the candidates on a prefix of the given number of instructions of every trace, returning the MPKI of each.
+ */
+using evaluator = std::function<std::vector<double>(const std::vector<candidate>&, long long)>;
+
+/**
+ * Search the candidates with successive halving.
+ *
+ * Every candidate is first evaluated on a prefix of schedule.min_instructions. Only the best 1/reduction of them are kept, and they
+ * are evaluated again, from the start, on a prefix that is reduction times longer. This repeats until the prefix reaches
+ * schedule.max_instructions, which the last candidates are always evaluated on.
+ *
+ * Returns every candidate, ranked first by how many rounds it survived, then by its MPKI in its last round.
+ */
+std::vector<result> successive_halving(const std::vector<candidate>& candidates, const halving_schedule& schedule, const evaluator& evaluate);
+
+/**
+ * Format the results as a table with one row per candidate, in the order given.
+ */
+std::vector<std::string> format_table(const search_space& space, const std::vector<result>& results);
+} // namespace champsim::sweep
+
+#endif
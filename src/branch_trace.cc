@@ -0,0 +1,251 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "branch_trace.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <zlib.h>
+
+#include "trace_instruction.h"
+
+namespace
+{
+void put_varint(std::vector<uint8_t>& payload, uint64_t value)
+{
+  constexpr uint64_t continuation = 0x80;
+  while (value >= continuation) {
+    payload.push_back(static_cast<uint8_t>(value | continuation));
+    value >>= 7;
+  }
+  payload.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t get_varint(const std::vector<uint8_t>& payload, std::size_t& position)
+{
+  constexpr uint8_t continuation = 0x80;
+  uint64_t value = 0;
+  for (unsigned shift = 0; shift < std::numeric_limits<uint64_t>::digits; shift += 7) {
+    if (position >= std::size(payload))
+      throw std::runtime_error{"Branch trace block ended in the middle of a branch"};
+    auto byte = payload[position++];
+    value |= static_cast<uint64_t>(byte & ~continuation) << shift;
+    if ((byte & continuation) == 0)
+      return value;
+  }
+  throw std::runtime_error{"Branch trace block holds a malformed integer"};
+}
+
+uint64_t zigzag(uint64_t to, uint64_t from)
+{
+  auto difference = static_cast<int64_t>(to - from);
+  return (static_cast<uint64_t>(difference) << 1) ^ static_cast<uint64_t>(difference >> 63);
+}
+
+uint64_t unzigzag(uint64_t encoded, uint64_t from) { return from + ((encoded >> 1) ^ (0 - (encoded & 1))); }
+} // namespace
+
+namespace champsim
+{
+void branch_trace_format::encode(std::vector<uint8_t>& payload, const branch_record& record, uint64_t previous_ip)
+{
+  const auto ip = record.ip.to<uint64_t>();
+  payload.push_back(static_cast<uint8_t>((record.type & TYPE_MASK) | (record.taken ? TAKEN_BIT : 0)));
+  put_varint(payload, zigzag(ip, previous_ip));
+  put_varint(payload, record.instructions);
+  if (record.taken)
+    put_varint(payload, zigzag(record.target.to<uint64_t>(), ip));
+}
+
+branch_record branch_trace_format::decode(const std::vector<uint8_t>& payload, std::size_t& position, uint64_t previous_ip)
+{
+  if (position >= std::size(payload))
+    throw std::runtime_error{"Branch trace block ended in the middle of a branch"};
+  const auto flags = payload[position++];
+
+  branch_record record;
+  record.type = static_cast<branch_type>(flags & TYPE_MASK);
+  record.taken = (flags & TAKEN_BIT) != 0;
+  const auto ip = unzigzag(get_varint(payload, position), previous_ip);
+  record.ip = champsim::address{ip};
+  record.instructions = get_varint(payload, position);
+  if (record.taken)
+    record.target = champsim::address{unzigzag(get_varint(payload, position), ip)};
+  return record;
+}
+
+branch_tracewriter::branch_tracewriter(const std::string& file_name, std::size_t records_per_block)
+    : file(file_name, std::ios::binary | std::ios::trunc), block_records(std::max<std::size_t>(records_per_block, 1))
+{
+  if (!file)
+    throw std::runtime_error{"Could not open branch trace " + file_name + " for writing"};
+
+  // The header is written again with the totals when the writer is closed
+  file.write(reinterpret_cast<const char*>(&totals), sizeof(totals)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+branch_tracewriter::~branch_tracewriter()
+{
+  if (file.is_open())
+    close();
+}
+
+void branch_tracewriter::operator()(const ooo_model_instr& instr)
+{
+  ++pending_instructions;
+  if (instr.is_branch) {
+    (*this)(make_record(instr, pending_instructions));
+    pending_instructions = 0;
+  }
+}
+
+void branch_tracewriter::operator()(const branch_record& record)
+{
+  branch_trace_format::encode(payload, record, previous_ip);
+  previous_ip = record.ip.to<uint64_t>();
+  ++block.records;
+  block.instructions += record.instructions;
+  ++totals.branches;
+  totals.instructions += record.instructions;
+
+  if (block.records >= block_records)
+    flush();
+}
+
+void branch_tracewriter::flush()
+{
+  if (block.records == 0)
+    return;
+
+  auto compressed_size = compressBound(static_cast<uLong>(std::size(payload)));
+  std::vector<Bytef> compressed(compressed_size);
+  if (compress2(std::data(compressed), &compressed_size, std::data(payload), static_cast<uLong>(std::size(payload)), Z_BEST_COMPRESSION) != Z_OK)
+    throw std::runtime_error{"Could not compress a branch trace block"};
+
+  block.raw_size = static_cast<uint32_t>(std::size(payload));
+  block.compressed_size = static_cast<uint32_t>(compressed_size);
+  file.write(reinterpret_cast<const char*>(&block), sizeof(block));             // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  file.write(reinterpret_cast<const char*>(std::data(compressed)), static_cast<std::streamsize>(compressed_size)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+  block = branch_trace_format::block_header{};
+  payload.clear();
+  previous_ip = 0;
+}
+
+void branch_tracewriter::close()
+{
+  flush();
+  totals.instructions += pending_instructions;
+  pending_instructions = 0;
+
+  file.seekp(0);
+  file.write(reinterpret_cast<const char*>(&totals), sizeof(totals)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  file.close();
+  if (file.fail())
+    throw std::runtime_error{"Could not finish writing the branch trace"};
+}
+
+branch_tracereader::branch_tracereader(const std::string& file_name) : file(file_name, std::ios::binary)
+{
+  if (!file)
+    throw std::runtime_error{"Could not open branch trace " + file_name};
+
+  file.read(reinterpret_cast<char*>(&header_), sizeof(header_)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (!file || header_.magic != branch_trace_format::MAGIC || header_.version != branch_trace_format::VERSION)
+    throw std::runtime_error{"File " + file_name + " is not a version " + std::to_string(branch_trace_format::VERSION) + " branch trace"};
+}
+
+bool branch_tracereader::is_branch_trace(const std::string& file_name)
+{
+  std::ifstream file{file_name, std::ios::binary};
+  std::array<char, std::size(branch_trace_format::MAGIC)> magic{};
+  file.read(std::data(magic), std::size(magic));
+  return file && magic == branch_trace_format::MAGIC;
+}
+
+bool branch_tracereader::read_block(std::vector<branch_record>& records)
+{
+  records.clear();
+
+  branch_trace_format::block_header block{};
+  file.read(reinterpret_cast<char*>(&block), sizeof(block)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (file.gcount() == 0 && file.eof())
+    return false;
+  if (!file)
+    throw std::runtime_error{"Branch trace ended in the middle of a block"};
+
+  compressed.resize(block.compressed_size);
+  file.read(reinterpret_cast<char*>(std::data(compressed)), static_cast<std::streamsize>(std::size(compressed))); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (!file)
+    throw std::runtime_error{"Branch trace ended in the middle of a block"};
+
+  payload.resize(block.raw_size);
+  auto raw_size = static_cast<uLongf>(block.raw_size);
+  if (uncompress(std::data(payload), &raw_size, std::data(compressed), static_cast<uLong>(std::size(compressed))) != Z_OK || raw_size != block.raw_size)
+    throw std::runtime_error{"Could not decompress a branch trace block"};
+
+  records.reserve(block.records);
+  std::size_t position = 0;
+  uint64_t previous_ip = 0;
+  for (uint32_t i = 0; i < block.records; ++i) {
+    records.push_back(branch_trace_format::decode(payload, position, previous_ip));
+    previous_ip = records.back().ip.to<uint64_t>();
+  }
+  return true;
+}
+
+bool branch_tracereader::next_block(std::vector<branch_record>& records)
+{
+  if (buffer_position < std::size(buffer)) {
+    records.assign(std::next(std::begin(buffer), static_cast<std::ptrdiff_t>(buffer_position)), std::end(buffer));
+    buffer_position = std::size(buffer);
+  } else if (!read_block(records)) {
+    return false;
+  }
+
+  branches_returned += std::size(records);
+  return true;
+}
+
+branch_record branch_tracereader::operator()()
+{
+  if (buffer_position >= std::size(buffer)) {
+    buffer_position = 0;
+    if (!read_block(buffer) || std::empty(buffer))
+      throw std::runtime_error{"Read past the end of a branch trace"};
+  }
+
+  ++branches_returned;
+  return buffer[buffer_position++];
+}
+
+branch_record make_record(const ooo_model_instr& instr, uint64_t instructions)
+{
+  return branch_record{instr.ip, instr.branch_target, instructions, instr.branch, instr.branch_taken};
+}
+
+ooo_model_instr make_instr(uint8_t cpu, const branch_record& record)
+{
+  ooo_model_instr instr{cpu, input_instr{}};
+  instr.ip = record.ip;
+  instr.is_branch = (record.type != NOT_BRANCH);
+  instr.branch_taken = record.taken;
+  instr.branch = record.type;
+  instr.branch_target = record.target;
+  return instr;
+}
+} // namespace champsim
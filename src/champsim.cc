@@ -19,11 +19,14 @@
 #include <algorithm>
 #include <chrono>
 #include <numeric>
+#include <stdexcept>
+#include <string>
 #include <vector>
 #include <fmt/chrono.h>
 #include <fmt/core.h>
 
 #include "environment.h"
+#include "msl/snapshot.h"
 #include "ooo_cpu.h"
 #include "operable.h"
 #include "phase_info.h"
@@ -180,13 +183,38 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
   return stats;
 }
 
+void save_branch_state(environment& env, const std::string& file_name)
+{
+  champsim::msl::snapshot_writer writer{file_name};
+  for (O3_CPU& cpu : env.cpu_view()) {
+    cpu.impl_save_branch_predictor(writer);
+  }
+}
+
+void load_branch_state(environment& env, const std::string& file_name)
+{
+  champsim::msl::snapshot_reader reader{file_name};
+  for (O3_CPU& cpu : env.cpu_view()) {
+    cpu.impl_load_branch_predictor(reader);
+  }
+
+  if (!reader.done()) {
+    throw std::runtime_error{"Branch predictor state in " + file_name + " has more tables than the configured predictors"};
+  }
+}
+
 // simulation entry point
-std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces)
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const std::string& branch_state_file)
 {
   for (champsim::operable& op : env.operable_view()) {
     op.initialize();
   }
 
+  // Restored state replaces whatever the predictors set up when they were initialized
+  if (!branch_state_file.empty()) {
+    load_branch_state(env, branch_state_file);
+  }
+
   champsim::chrono::clock global_clock;
   std::vector<phase_stats> results;
   for (auto phase : phases) {
@@ -1,5 +1,35 @@
 #include "core_stats.h"
 
+#include <algorithm>
+#include <functional>
+
+meta_predictor_stats operator-(meta_predictor_stats lhs, const meta_predictor_stats& rhs)
+{
+  auto subtract = [](std::vector<uint64_t>& minuend, const std::vector<uint64_t>& subtrahend) {
+    auto count = std::min(std::size(minuend), std::size(subtrahend));
+    std::transform(std::begin(minuend), std::next(std::begin(minuend), static_cast<long>(count)), std::begin(subtrahend), std::begin(minuend), std::minus<>{});
+  };
+
+  subtract(lhs.arm_selections, rhs.arm_selections);
+  subtract(lhs.arm_correct, rhs.arm_correct);
+  subtract(lhs.arm_incorrect, rhs.arm_incorrect);
+  lhs.regret -= rhs.regret;
+  lhs.regret_branches -= rhs.regret_branches;
+  lhs.oracle_branches -= rhs.oracle_branches;
+  lhs.chooser_correct -= rhs.chooser_correct;
+  lhs.oracle_correct -= rhs.oracle_correct;
+  lhs.static_best_correct -= rhs.static_best_correct;
+  lhs.gated_branches -= rhs.gated_branches;
+  lhs.gated_evaluations -= rhs.gated_evaluations;
+  lhs.gate_probes -= rhs.gate_probes;
+  lhs.arms_gated -= rhs.arms_gated;
+  lhs.arms_reopened -= rhs.arms_reopened;
+  std::transform(std::begin(lhs.convergence_times), std::end(lhs.convergence_times), std::begin(rhs.convergence_times), std::begin(lhs.convergence_times),
+                 std::minus<>{});
+
+  return lhs;
+}
+
 cpu_stats operator-(cpu_stats lhs, cpu_stats rhs)
 {
   lhs.begin_instrs -= rhs.begin_instrs;
@@ -11,5 +41,7 @@ cpu_stats operator-(cpu_stats lhs, cpu_stats rhs)
   lhs.total_branch_types -= rhs.total_branch_types;
   lhs.branch_type_misses -= rhs.branch_type_misses;
 
+  lhs.meta_predictor = lhs.meta_predictor - rhs.meta_predictor;
+
   return lhs;
 }
@@ -37,6 +37,34 @@ void to_json(nlohmann::json& j, const O3_CPU::stats_type& stats)
                      {"cycles", stats.cycles()},
                      {"Avg ROB occupancy at mispredict", std::ceil(stats.total_rob_occupancy_at_branch_mispredict) / std::ceil(total_mispredictions)},
                      {"mispredict", mpki}};
+
+  if (stats.branch_predictor_storage_bits > 0)
+    j.emplace("branch predictor storage bits", stats.branch_predictor_storage_bits);
+
+  const auto& meta = stats.meta_predictor;
+  if (!std::empty(meta.arm_selections)) {
+    nlohmann::json meta_json{{"selected", meta.arm_selections},
+                             {"correct", meta.arm_correct},
+                             {"incorrect", meta.arm_incorrect},
+                             {"regret", meta.regret},
+                             {"regret branches", meta.regret_branches},
+                             {"convergence time", meta.convergence_times},
+                             {"unconverged", meta.unconverged}};
+    if (meta.oracle_branches > 0) {
+      meta_json.emplace("oracle", nlohmann::json{{"branches", meta.oracle_branches},
+                                                 {"chooser correct", meta.chooser_correct},
+                                                 {"oracle correct", meta.oracle_correct},
+                                                 {"static best correct", meta.static_best_correct}});
+    }
+    if (meta.gated_branches > 0) {
+      meta_json.emplace("gating", nlohmann::json{{"branches", meta.gated_branches},
+                                                 {"arm evaluations", meta.gated_evaluations},
+                                                 {"probes", meta.gate_probes},
+                                                 {"arms gated", meta.arms_gated},
+                                                 {"arms reopened", meta.arms_reopened}});
+    }
+    j.emplace("meta predictor", meta_json);
+  }
 }
 
 void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
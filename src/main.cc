@@ -37,8 +37,9 @@
 
 namespace champsim
 {
-std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces);
-}
+std::vector<phase_stats> main(environment& env, std::vector<phase_info>& phases, std::vector<tracereader>& traces, const std::string& branch_state_file);
+void save_branch_state(environment& env, const std::string& file_name);
+} // namespace champsim
 
 #ifndef CHAMPSIM_TEST_BUILD
 using configured_environment = champsim::configured::generated_environment<CHAMPSIM_BUILD>;
@@ -62,6 +63,8 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   long long warmup_instructions = 0;
   long long simulation_instructions = std::numeric_limits<long long>::max();
   std::string json_file_name;
+  std::string load_branch_file_name;
+  std::string save_branch_file_name;
   std::vector<std::string> trace_names;
 
   auto set_heartbeat_callback = [&](auto) {
@@ -83,6 +86,10 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   auto* json_option =
       app.add_option("--json", json_file_name, "The name of the file to receive JSON output. If no name is specified, stdout will be used")->expected(0, 1);
 
+  app.add_option("--load-branch-state", load_branch_file_name, "Restore the branch predictors from this snapshot before the warmup phase")
+      ->check(CLI::ExistingFile);
+  app.add_option("--save-branch-state", save_branch_file_name, "Save a snapshot of the branch predictors to this file at the end of the simulation");
+
   app.add_option("traces", trace_names, "The paths to the traces")->required()->expected(NUM_CPUS)->check(CLI::ExistingFile);
 
   CLI11_PARSE(app, argc, argv);
@@ -120,12 +127,20 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   fmt::print("\n*** ChampSim Multicore Out-of-Order Simulator ***\nWarmup Instructions: {}\nSimulation Instructions: {}\nNumber of CPUs: {}\nPage size: {}\n\n",
              phases.at(0).length, phases.at(1).length, std::size(gen_environment.cpu_view()), PAGE_SIZE);
 
-  auto phase_stats = champsim::main(gen_environment, phases, traces);
+  auto phase_stats = champsim::main(gen_environment, phases, traces, load_branch_file_name);
+
+  if (!save_branch_file_name.empty()) {
+    champsim::save_branch_state(gen_environment, save_branch_file_name);
+  }
 
   fmt::print("\nChampSim completed all CPUs\n\n");
 
   champsim::plain_printer{std::cout}.print(phase_stats);
 
+  for (O3_CPU& cpu : gen_environment.cpu_view()) {
+    cpu.impl_branch_predictor_final_stats();
+  }
+
   for (CACHE& cache : gen_environment.cache_view()) {
     cache.impl_prefetcher_final_stats();
   }
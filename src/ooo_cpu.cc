@@ -88,7 +88,11 @@ void O3_CPU::begin_phase()
   stats.name = "CPU " + std::to_string(cpu);
   stats.begin_instrs = num_retired;
   stats.begin_cycles = begin_phase_time.time_since_epoch() / clock_period;
+  stats.branch_predictor_storage_bits = impl_branch_predictor_storage_bits();
   sim_stats = stats;
+
+  impl_begin_phase_branch_predictor();
+  begin_phase_meta_predictor_stats = impl_meta_predictor_telemetry();
 }
 
 void O3_CPU::end_phase(unsigned finished_cpu)
@@ -96,6 +100,7 @@ void O3_CPU::end_phase(unsigned finished_cpu)
   // Record where the phase ended (overwrite if this is later)
   sim_stats.end_instrs = num_retired;
   sim_stats.end_cycles = current_time.time_since_epoch() / clock_period;
+  sim_stats.meta_predictor = impl_meta_predictor_telemetry() - begin_phase_meta_predictor_stats;
 
   if (finished_cpu == this->cpu) {
     finish_phase_instr = num_retired;
@@ -154,7 +159,9 @@ bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
   // handle branch prediction for all instructions as at this point we do not know if the instruction is a branch
   sim_stats.total_branch_types.increment(arch_instr.branch);
   auto [predicted_branch_target, always_taken] = impl_btb_prediction(arch_instr.ip, arch_instr.branch);
-  arch_instr.branch_prediction = impl_predict_branch(arch_instr.ip, predicted_branch_target, always_taken, arch_instr.branch) || always_taken;
+  arch_instr.branch_prediction_id = next_branch_prediction_id++;
+  arch_instr.branch_prediction =
+      impl_predict_branch(arch_instr.branch_prediction_id, arch_instr.ip, predicted_branch_target, always_taken, arch_instr.branch) || always_taken;
   if (!arch_instr.branch_prediction) {
     predicted_branch_target = champsim::address{};
   }
@@ -167,27 +174,47 @@ bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
     // call code prefetcher every time the branch predictor is used
     l1i->impl_prefetcher_branch_operate(arch_instr.ip, arch_instr.branch, predicted_branch_target);
 
-    if (predicted_branch_target != arch_instr.branch_target
-        || (((arch_instr.branch == BRANCH_CONDITIONAL) || (arch_instr.branch == BRANCH_OTHER))
-            && arch_instr.branch_taken != arch_instr.branch_prediction)) { // conditional branches are re-evaluated at decode when the target is computed
+    if (is_mispredicted(arch_instr, predicted_branch_target)) {
       sim_stats.total_rob_occupancy_at_branch_mispredict += std::size(ROB);
       sim_stats.branch_type_misses.increment(arch_instr.branch);
       if (!warmup) {
         fetch_resume_time = champsim::chrono::clock::time_point::max();
         stop_fetch = true;
         arch_instr.branch_mispredicted = true;
+      } else {
+        // Fetch does not stall during warmup, so the correct path is fetched at once
+        do_repair_branch_history(arch_instr);
       }
     } else {
       stop_fetch = arch_instr.branch_taken; // if correctly predicted taken, then we can't fetch anymore instructions this cycle
     }
 
     impl_update_btb(arch_instr.ip, arch_instr.branch_target, arch_instr.branch_taken, arch_instr.branch);
-    impl_last_branch_result(arch_instr.ip, arch_instr.branch_target, arch_instr.branch_taken, arch_instr.branch);
+    if (BRANCH_RESOLUTION == champsim::branch_resolution_stage::fetch) {
+      do_resolve_branch(arch_instr);
+    }
   }
 
   return stop_fetch;
 }
 
+void O3_CPU::do_resolve_branch(const ooo_model_instr& instr)
+{
+  impl_last_branch_result(instr.branch_prediction_id, instr.ip, instr.branch_target, instr.branch_taken, instr.branch);
+}
+
+void O3_CPU::do_repair_branch_history(const ooo_model_instr& instr)
+{
+  impl_repair_branch_history(instr.branch_prediction_id, instr.ip, instr.branch_target, instr.branch_taken, instr.branch);
+}
+
+bool O3_CPU::is_mispredicted(const ooo_model_instr& instr, champsim::address predicted_target)
+{
+  // conditional branches are re-evaluated at decode when the target is computed
+  return predicted_target != instr.branch_target
+         || (((instr.branch == BRANCH_CONDITIONAL) || (instr.branch == BRANCH_OTHER)) && instr.branch_taken != instr.branch_prediction);
+}
+
 bool O3_CPU::do_init_instruction(ooo_model_instr& arch_instr)
 {
   // fast warmup eliminates register dependencies between instructions branch predictor, cache contents, and prefetchers are still warmed up
@@ -375,6 +402,7 @@ long O3_CPU::decode_instruction()
         db_entry.branch_mispredicted = 0;
         // pay misprediction penalty
         this->fetch_resume_time = this->current_time + BRANCH_MISPREDICT_PENALTY;
+        this->do_repair_branch_history(db_entry);
       }
     }
     // Add to dispatch
@@ -639,8 +667,13 @@ void O3_CPU::do_complete_execution(ooo_model_instr& instr)
 
   instr.completed = true;
 
+  if (instr.is_branch && BRANCH_RESOLUTION == champsim::branch_resolution_stage::execute) {
+    do_resolve_branch(instr);
+  }
+
   if (instr.branch_mispredicted) {
     fetch_resume_time = current_time + BRANCH_MISPREDICT_PENALTY;
+    do_repair_branch_history(instr);
   }
 }
 
@@ -721,6 +754,10 @@ long O3_CPU::retire_rob()
     for (auto dreg : rob_it->destination_registers) {
       reg_allocator.retire_dest_register(dreg);
     }
+
+    if (rob_it->is_branch && BRANCH_RESOLUTION == champsim::branch_resolution_stage::retire) {
+      do_resolve_branch(*rob_it);
+    }
   }
 
   auto retire_count = std::distance(retire_begin, retire_end);
@@ -732,16 +769,34 @@ long O3_CPU::retire_rob()
 
 void O3_CPU::impl_initialize_branch_predictor() const { branch_module_pimpl->impl_initialize_branch_predictor(); }
 
-void O3_CPU::impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const
+void O3_CPU::impl_last_branch_result(branch_prediction_id id, champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const
+{
+  branch_module_pimpl->impl_last_branch_result(id, ip, target, taken, branch_type);
+}
+
+bool O3_CPU::impl_predict_branch(branch_prediction_id id, champsim::address ip, champsim::address predicted_target, bool always_taken,
+                                 uint8_t branch_type) const
 {
-  branch_module_pimpl->impl_last_branch_result(ip, target, taken, branch_type);
+  return branch_module_pimpl->impl_predict_branch(id, ip, predicted_target, always_taken, branch_type);
 }
 
-bool O3_CPU::impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) const
+void O3_CPU::impl_repair_branch_history(branch_prediction_id id, champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const
 {
-  return branch_module_pimpl->impl_predict_branch(ip, predicted_target, always_taken, branch_type);
+  branch_module_pimpl->impl_repair_branch_history(id, ip, target, taken, branch_type);
 }
 
+void O3_CPU::impl_save_branch_predictor(champsim::msl::snapshot_writer& writer) const { branch_module_pimpl->impl_save_branch_predictor(writer); }
+
+void O3_CPU::impl_load_branch_predictor(champsim::msl::snapshot_reader& reader) const { branch_module_pimpl->impl_load_branch_predictor(reader); }
+
+meta_predictor_stats O3_CPU::impl_meta_predictor_telemetry() const { return branch_module_pimpl->impl_meta_predictor_telemetry(); }
+
+void O3_CPU::impl_begin_phase_branch_predictor() const { branch_module_pimpl->impl_begin_phase_branch_predictor(); }
+
+void O3_CPU::impl_branch_predictor_final_stats() const { branch_module_pimpl->impl_branch_predictor_final_stats(); }
+
+std::size_t O3_CPU::impl_branch_predictor_storage_bits() const { return branch_module_pimpl->impl_branch_predictor_storage_bits(); }
+
 void O3_CPU::impl_initialize_btb() const { btb_module_pimpl->impl_initialize_btb(); }
 
 void O3_CPU::impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) const
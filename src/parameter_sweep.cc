@@ -0,0 +1,182 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parameter_sweep.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <fmt/core.h>
+
+#include "msl/xoshiro.h"
+
+namespace
+{
+double parse_number(const std::string& name, std::string_view text)
+{
+  std::string number{text};
+  std::size_t used = 0;
+  double value = 0;
+  try {
+    value = std::stod(number, &used);
+  } catch (const std::logic_error&) {
+    used = 0;
+  }
+  if (used == 0 || used != std::size(number))
+    throw std::invalid_argument{"The value '" + number + "' for parameter " + name + " is not a number"};
+  return value;
+}
+
+std::vector<std::string_view> split(std::string_view text, char delimiter)
+{
+  std::vector<std::string_view> result;
+  for (auto next = text.find(delimiter); next != std::string_view::npos; next = text.find(delimiter)) {
+    result.push_back(text.substr(0, next));
+    text.remove_prefix(next + 1);
+  }
+  result.push_back(text);
+  return result;
+}
+} // namespace
+
+namespace champsim::sweep
+{
+parameter_space parameter_space::parse(std::string name, std::string_view spec)
+{
+  parameter_space result{};
+  result.name = std::move(name);
+
+  if (spec.find(':') == std::string_view::npos) {
+    for (auto value : split(spec, ','))
+      result.values.push_back(parse_number(result.name, value));
+    return result;
+  }
+
+  auto bounds = split(spec, ':');
+  if (std::size(bounds) > 3 || (std::size(bounds) == 3 && bounds[2] != "log"))
+    throw std::invalid_argument{"The range '" + std::string{spec} + "' for parameter " + result.name + " is not of the form lower:upper or lower:upper:log"};
+
+  result.lower = parse_number(result.name, bounds[0]);
+  result.upper = parse_number(result.name, bounds[1]);
+  result.logarithmic = (std::size(bounds) == 3);
+  if (result.lower > result.upper)
+    throw std::invalid_argument{"The range for parameter " + result.name + " is empty"};
+  if (result.logarithmic && result.lower <= 0)
+    throw std::invalid_argument{"The logarithmic range for parameter " + result.name + " must be positive"};
+  return result;
+}
+
+std::vector<candidate> grid(const search_space& space)
+{
+  std::vector<candidate> result{candidate{}};
+  for (const auto& parameter : space) {
+    if (std::empty(parameter.values))
+      throw std::invalid_argument{"Parameter " + parameter.name + " is a range, which cannot be searched on a grid"};
+
+    std::vector<candidate> extended;
+    extended.reserve(std::size(result) * std::size(parameter.values));
+    for (const auto& partial : result) {
+      for (auto value : parameter.values) {
+        extended.push_back(partial);
+        extended.back().push_back(value);
+      }
+    }
+    result = std::move(extended);
+  }
+  return result;
+}
+
+std::vector<candidate> sample(const search_space& space, std::size_t count, uint64_t seed)
+{
+  champsim::msl::xoshiro256starstar rng{seed};
+  std::vector<candidate> result(count);
+  for (auto& choice : result) {
+    for (const auto& parameter : space) {
+      double value = 0;
+      if (!std::empty(parameter.values)) {
+        value = parameter.values.at(std::uniform_int_distribution<std::size_t>{0, std::size(parameter.values) - 1}(rng));
+      } else if (parameter.logarithmic) {
+        value = std::exp(std::uniform_real_distribution<double>{std::log(parameter.lower), std::log(parameter.upper)}(rng));
+      } else {
+        value = std::uniform_real_distribution<double>{parameter.lower, parameter.upper}(rng);
+      }
+      choice.push_back(parameter.integral ? std::round(value) : value);
+    }
+  }
+  return result;
+}
+
+std::vector<result> successive_halving(const std::vector<candidate>& candidates, const halving_schedule& schedule, const evaluator& evaluate)
+{
+  std::vector<result> results;
+  std::transform(std::begin(candidates), std::end(candidates), std::back_inserter(results), [](const auto& parameters) { return result{parameters}; });
+
+  std::vector<std::size_t> survivors(std::size(candidates));
+  std::iota(std::begin(survivors), std::end(survivors), 0);
+
+  const auto reduction = std::max(schedule.reduction, 2u);
+  auto length = std::min(schedule.min_instructions, schedule.max_instructions);
+  while (!std::empty(survivors)) {
+    std::vector<candidate> round;
+    std::transform(std::begin(survivors), std::end(survivors), std::back_inserter(round), [&](auto i) { return candidates.at(i); });
+
+    auto mpki = evaluate(round, length);
+    for (std::size_t i = 0; i < std::size(survivors); ++i) {
+      auto& entry = results.at(survivors[i]);
+      ++entry.rounds;
+      entry.instructions = length;
+      entry.mpki = mpki.at(i);
+    }
+
+    if (length >= schedule.max_instructions)
+      break;
+
+    // Keep the best, and if there is only one left, go straight to the full length
+    std::stable_sort(std::begin(survivors), std::end(survivors), [&](auto lhs, auto rhs) { return results.at(lhs).mpki < results.at(rhs).mpki; });
+    survivors.resize((std::size(survivors) + reduction - 1) / reduction);
+    if (std::size(survivors) == 1 || length > schedule.max_instructions / reduction)
+      length = schedule.max_instructions;
+    else
+      length *= reduction;
+  }
+
+  std::stable_sort(std::begin(results), std::end(results), [](const auto& lhs, const auto& rhs) {
+    return lhs.rounds > rhs.rounds || (lhs.rounds == rhs.rounds && lhs.mpki < rhs.mpki);
+  });
+  return results;
+}
+
+std::vector<std::string> format_table(const search_space& space, const std::vector<result>& results)
+{
+  std::string header = fmt::format("{:>5}", "Rank");
+  for (const auto& parameter : space)
+    header += fmt::format(" {:>16}", parameter.name);
+  header += fmt::format(" {:>6} {:>14} {:>10}", "Rounds", "Instructions", "MPKI");
+
+  std::vector<std::string> lines{header};
+  std::size_t rank = 1;
+  for (const auto& entry : results) {
+    std::string line = fmt::format("{:>5}", rank++);
+    for (auto value : entry.parameters)
+      line += fmt::format(" {:>16.6g}", value);
+    line += fmt::format(" {:>6} {:>14} {:>10.4f}", entry.rounds, entry.instructions, entry.mpki);
+    lines.push_back(line);
+  }
+  return lines;
+}
+} // namespace champsim::sweep
@@ -56,12 +56,43 @@ std::vector<std::string> champsim::plain_printer::format(O3_CPU::stats_type stat
                               ::print_ratio(std::kilo::num * total_mispredictions, stats.instrs()),
                               ::print_ratio(stats.total_rob_occupancy_at_branch_mispredict, total_mispredictions)));
 
+  if (stats.branch_predictor_storage_bits > 0) {
+    lines.push_back(fmt::format("{} Branch predictor storage: {} bits ({:.1f} KiB)", stats.name, stats.branch_predictor_storage_bits,
+                                static_cast<double>(stats.branch_predictor_storage_bits) / (8 * 1024)));
+  }
+
   lines.emplace_back("Branch type MPKI");
   for (auto idx : types) {
     lines.push_back(fmt::format("{}: {}", branch_type_names.at(champsim::to_underlying(idx)),
                                 ::print_ratio(std::kilo::num * stats.branch_type_misses.value_or(idx, 0), stats.instrs())));
   }
 
+  const auto& meta = stats.meta_predictor;
+  if (!std::empty(meta.arm_selections)) {
+    lines.push_back(fmt::format("{} Meta predictor regret: {} over {} branches", stats.name, meta.regret, meta.regret_branches));
+    if (meta.oracle_branches > 0) {
+      lines.push_back(fmt::format("{} Meta predictor chooser accuracy: {}% oracle accuracy: {}% static best arm accuracy: {}% over {} branches", stats.name,
+                                  ::print_ratio(100 * meta.chooser_correct, meta.oracle_branches), ::print_ratio(100 * meta.oracle_correct, meta.oracle_branches),
+                                  ::print_ratio(100 * meta.static_best_correct, meta.oracle_branches), meta.oracle_branches));
+    }
+    if (meta.gated_branches > 0) {
+      lines.push_back(fmt::format("{} Meta predictor gating: {} of {} arms evaluated per branch over {} branches probes: {} arms gated: {} reopened: {}",
+                                  stats.name, ::print_ratio(meta.gated_evaluations, meta.gated_branches), std::size(meta.arm_selections),
+                                  meta.gated_branches, meta.gate_probes, meta.arms_gated, meta.arms_reopened));
+    }
+    for (std::size_t arm = 0; arm < std::size(meta.arm_selections); ++arm) {
+      lines.push_back(fmt::format("{} Meta predictor arm {} selected: {} correct: {} incorrect: {} accuracy: {}%", stats.name, arm, meta.arm_selections.at(arm),
+                                  meta.arm_correct.at(arm), meta.arm_incorrect.at(arm),
+                                  ::print_ratio(100 * meta.arm_correct.at(arm), meta.arm_correct.at(arm) + meta.arm_incorrect.at(arm))));
+    }
+
+    std::string convergence = fmt::format("{} Meta predictor convergence time:", stats.name);
+    for (std::size_t bin = 0; bin < std::size(meta.convergence_times); ++bin) {
+      convergence += fmt::format(" {}: {}", (bin == 0) ? 0 : (1ull << (bin - 1)), meta.convergence_times.at(bin));
+    }
+    lines.push_back(convergence + fmt::format(" unconverged: {}", meta.unconverged));
+  }
+
   return lines;
 }
 
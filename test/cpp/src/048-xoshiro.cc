@@ -0,0 +1,40 @@
+#include <catch.hpp>
+#include "msl/xoshiro.h"
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+TEST_CASE("Two xoshiro generators with the same seed produce the same sequence") {
+  auto seed = GENERATE(0ull, 1ull, 0xdeadbeefull);
+  champsim::msl::xoshiro256starstar lhs{seed};
+  champsim::msl::xoshiro256starstar rhs{seed};
+
+  for (int i = 0; i < 100; ++i)
+    REQUIRE(lhs() == rhs());
+}
+
+TEST_CASE("Two xoshiro generators with adjacent seeds produce different sequences") {
+  champsim::msl::xoshiro256starstar lhs{1};
+  champsim::msl::xoshiro256starstar rhs{2};
+
+  std::array<uint64_t, 8> lhs_draws{};
+  std::array<uint64_t, 8> rhs_draws{};
+  std::generate(std::begin(lhs_draws), std::end(lhs_draws), lhs);
+  std::generate(std::begin(rhs_draws), std::end(rhs_draws), rhs);
+  REQUIRE(lhs_draws != rhs_draws);
+}
+
+TEST_CASE("A xoshiro generator can drive the standard distributions") {
+  champsim::msl::xoshiro256starstar uut{};
+  std::uniform_int_distribution<int> dist{0, 3};
+
+  std::array<int, 4> histogram{};
+  for (int i = 0; i < 4000; ++i)
+    ++histogram.at(static_cast<std::size_t>(dist(uut)));
+
+  for (auto count : histogram) {
+    CHECK(count > 800);
+    CHECK(count < 1200);
+  }
+}
@@ -0,0 +1,85 @@
+#include <catch.hpp>
+#include "msl/snapshot.h"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+std::string snapshot_path(const std::string& name) { return (std::filesystem::temp_directory_path() / ("champsim-" + name + ".snap")).string(); }
+} // namespace
+
+TEST_CASE("A snapshot restores the tables it was written from") {
+  auto file_name = snapshot_path("roundtrip");
+
+  std::array<int16_t, 5> array_table{{-3, 1, 4, -1, 5}};
+  std::vector<uint32_t> vector_table{9, 2, 6, 5, 3, 5};
+  uint64_t scalar = 0xdeadbeef;
+  {
+    champsim::msl::snapshot_writer writer{file_name};
+    writer(array_table);
+    writer(vector_table);
+    writer(scalar);
+  }
+
+  std::array<int16_t, 5> restored_array{};
+  std::vector<uint32_t> restored_vector(std::size(vector_table));
+  uint64_t restored_scalar = 0;
+  champsim::msl::snapshot_reader reader{file_name};
+  reader(restored_array);
+  reader(restored_vector);
+  REQUIRE_FALSE(reader.done());
+  reader(restored_scalar);
+
+  REQUIRE(reader.done());
+  REQUIRE(restored_array == array_table);
+  REQUIRE(restored_vector == vector_table);
+  REQUIRE(restored_scalar == scalar);
+
+  std::filesystem::remove(file_name);
+}
+
+TEST_CASE("A snapshot cannot be restored into a table of a different size") {
+  auto file_name = snapshot_path("mismatch");
+  {
+    champsim::msl::snapshot_writer writer{file_name};
+    writer(std::vector<uint8_t>(16));
+  }
+
+  std::vector<uint8_t> restored(32);
+  champsim::msl::snapshot_reader reader{file_name};
+  REQUIRE_THROWS_AS(reader(restored), std::runtime_error);
+
+  std::filesystem::remove(file_name);
+}
+
+TEST_CASE("A snapshot cannot be restored past the end of the file") {
+  auto file_name = snapshot_path("short");
+  {
+    champsim::msl::snapshot_writer writer{file_name};
+    writer(uint32_t{1});
+  }
+
+  uint32_t first = 0;
+  uint32_t second = 0;
+  champsim::msl::snapshot_reader reader{file_name};
+  reader(first);
+  REQUIRE_THROWS_AS(reader(second), std::runtime_error);
+
+  std::filesystem::remove(file_name);
+}
+
+TEST_CASE("A file that is not a snapshot is rejected") {
+  auto file_name = snapshot_path("not-a-snapshot");
+  {
+    std::ofstream file{file_name, std::ios::binary};
+    file << "This is not a snapshot, but it is long enough to have a header";
+  }
+
+  REQUIRE_THROWS_AS(champsim::msl::snapshot_reader{file_name}, std::runtime_error);
+
+  std::filesystem::remove(file_name);
+}
@@ -0,0 +1,64 @@
+#include <catch.hpp>
+#include "msl/sequence_ring.h"
+
+TEST_CASE("A sequence ring finds entries by the sequence number they were pushed with") {
+  champsim::msl::sequence_ring<int, 4> uut;
+  REQUIRE(uut.last() == decltype(uut)::INVALID);
+
+  auto first = uut.push(10);
+  auto second = uut.push(20);
+  REQUIRE(second == first + 1);
+  REQUIRE(uut.last() == second);
+
+  REQUIRE(uut.find(first) != nullptr);
+  REQUIRE(*uut.find(first) == 10);
+  REQUIRE(*uut.find(second) == 20);
+  REQUIRE(uut.find(second + 1) == nullptr);
+}
+
+TEST_CASE("A sequence ring does not find erased entries") {
+  champsim::msl::sequence_ring<int, 4> uut;
+  auto first = uut.push(10);
+  auto second = uut.push(10);
+
+  uut.erase(first);
+  REQUIRE(uut.find(first) == nullptr);
+  REQUIRE(*uut.find(second) == 10);
+
+  uut.erase(first);
+  REQUIRE(*uut.find(second) == 10);
+}
+
+TEST_CASE("A sequence ring does not find overwritten entries, even with the same slot") {
+  champsim::msl::sequence_ring<int, 4> uut;
+  auto first = uut.push(10);
+  for (int i = 0; i < 4; ++i)
+    uut.push(20 + i);
+
+  REQUIRE(uut.find(first) == nullptr);
+  REQUIRE(*uut.find(first + 4) == 23);
+  REQUIRE(*uut.find(first + 1) == 20);
+
+  // Erasing a stale sequence number does not erase its replacement
+  uut.erase(first);
+  REQUIRE(*uut.find(first + 4) == 23);
+}
+
+TEST_CASE("A sequence ring finds entries by the sequence numbers they were pushed with") {
+  champsim::msl::sequence_ring<int, 4> uut;
+  uut.push(100, 10);
+  uut.push(103, 13);
+
+  REQUIRE(*uut.find(100) == 10);
+  REQUIRE(*uut.find(103) == 13);
+  REQUIRE(uut.find(101) == nullptr);
+  REQUIRE(uut.last() == 103);
+
+  // A later number in the same slot overwrites the entry
+  uut.push(104, 14);
+  REQUIRE(uut.find(100) == nullptr);
+  REQUIRE(*uut.find(104) == 14);
+
+  // Numbers continue from the last one given
+  REQUIRE(uut.push(20) == 105);
+}
@@ -0,0 +1,66 @@
+#include <catch.hpp>
+#include "msl/fwcounter.h"
+#include "msl/packed_counter_array.h"
+
+#include <array>
+#include <random>
+
+TEST_CASE("A packed counter array starts at zero") {
+  champsim::msl::packed_counter_array<2, 100> uut;
+  for (std::size_t i = 0; i < uut.size(); ++i)
+    REQUIRE(uut[i] == 0);
+}
+
+TEST_CASE("A packed counter saturates at its maximum and at zero") {
+  champsim::msl::packed_counter_array<2, 100> uut;
+  STATIC_REQUIRE(decltype(uut)::maximum == 3);
+
+  for (int i = 0; i < 10; ++i)
+    uut.increment(31);
+  REQUIRE(uut[31] == 3);
+
+  for (int i = 0; i < 10; ++i)
+    uut.decrement(31);
+  REQUIRE(uut[31] == 0);
+}
+
+TEST_CASE("Updating a packed counter does not disturb its neighbors") {
+  champsim::msl::packed_counter_array<4, 64> uut;
+  for (int i = 0; i < 20; ++i)
+    uut.increment(15);
+  uut.increment(16);
+  uut.decrement(14);
+
+  REQUIRE(uut[14] == 0);
+  REQUIRE(uut[15] == 15);
+  REQUIRE(uut[16] == 1);
+  REQUIRE(uut[17] == 0);
+}
+
+TEST_CASE("A packed counter is strongest at either end of its range") {
+  using two_bit = champsim::msl::packed_counter_array<2, 1>;
+  CHECK(two_bit::strength(0) == 1.0f);
+  CHECK(two_bit::strength(1) == 0.0f);
+  CHECK(two_bit::strength(2) == 0.0f);
+  CHECK(two_bit::strength(3) == 1.0f);
+
+  using three_bit = champsim::msl::packed_counter_array<3, 1>;
+  CHECK(three_bit::strength(3) == 0.0f);
+  CHECK(three_bit::strength(5) == Approx(1.0 / 3));
+  CHECK(three_bit::strength(0) == 1.0f);
+}
+
+TEMPLATE_TEST_CASE_SIG("A packed counter array behaves as an array of fwcounters", "", ((std::size_t WIDTH), WIDTH), 1, 2, 3, 4, 8, 16) {
+  constexpr std::size_t SIZE = 1000;
+  champsim::msl::packed_counter_array<WIDTH, SIZE> uut;
+  std::array<champsim::msl::fwcounter<WIDTH>, SIZE> reference{};
+
+  std::mt19937_64 rng{WIDTH};
+  for (int i = 0; i < 100'000; ++i) {
+    const auto index = rng() % 16;
+    const auto up = (rng() % 3) != 0;
+    uut.update(index, up);
+    reference[index] += up ? 1 : -1;
+    REQUIRE(uut[index] == reference[index].value());
+  }
+}
@@ -0,0 +1,75 @@
+#include <catch.hpp>
+#include "msl/speculative_history.h"
+
+#include <array>
+#include <deque>
+#include <random>
+
+namespace
+{
+using history_type = champsim::msl::speculative_history<256, 4>;
+constexpr std::array<history_type::fold_shape, 4> shapes{{{0, 8}, {5, 8}, {37, 7}, {130, 11}}};
+
+// Fold the newest length outcomes, width bits at a time, the newest outcome in the lowest bit
+history_type::folded_type naive_fold(const std::deque<bool>& outcomes, history_type::fold_shape shape)
+{
+  history_type::folded_type result = 0;
+  for (std::size_t age = 0; age < shape.length && age < std::size(outcomes); ++age)
+    result ^= static_cast<history_type::folded_type>(history_type::folded_type{outcomes[age]} << (age % shape.width));
+  return result;
+}
+} // namespace
+
+TEST_CASE("A speculative history folds its newest outcomes") {
+  history_type uut{shapes};
+  std::deque<bool> reference;
+
+  std::mt19937_64 rng{52};
+  for (int i = 0; i < 1000; ++i) {
+    const bool outcome = (rng() % 3) != 0;
+    uut.push(outcome);
+    reference.push_front(outcome);
+
+    REQUIRE(uut.at(0) == outcome);
+    for (std::size_t fold = 0; fold < std::size(shapes); ++fold)
+      REQUIRE(uut.folded(fold) == naive_fold(reference, shapes[fold]));
+  }
+}
+
+TEST_CASE("Repairing a speculative history gives the history of the correct outcome") {
+  history_type uut{shapes};
+  history_type reference{shapes};
+  for (bool outcome : {true, true, false, true, false, false, true}) {
+    uut.push(outcome);
+    reference.push(outcome);
+  }
+
+  auto saved = uut.speculate(true);
+  REQUIRE_FALSE(uut.repair(saved, true));
+  REQUIRE(uut.repair(saved, false));
+  REQUIRE_FALSE(uut.repair(saved, false));
+  reference.push(false);
+
+  for (std::size_t fold = 0; fold < std::size(shapes); ++fold)
+    REQUIRE(uut.folded(fold) == reference.folded(fold));
+}
+
+TEST_CASE("Repairing a speculative history discards the outcomes pushed after the checkpoint") {
+  history_type uut{shapes};
+  history_type reference{shapes};
+  for (bool outcome : {false, true, true, false}) {
+    uut.push(outcome);
+    reference.push(outcome);
+  }
+
+  auto saved = uut.speculate(false);
+  for (int i = 0; i < 100; ++i)
+    (void)uut.speculate(i % 2 == 0);
+  REQUIRE(uut.repair(saved, true));
+  reference.push(true);
+
+  for (std::size_t age = 0; age < 5; ++age)
+    REQUIRE(uut.at(age) == reference.at(age));
+  for (std::size_t fold = 0; fold < std::size(shapes); ++fold)
+    REQUIRE(uut.folded(fold) == reference.folded(fold));
+}
@@ -0,0 +1,126 @@
+#include <catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "branch_trace.h"
+
+namespace
+{
+std::string branch_trace_path(const std::string& name) { return (std::filesystem::temp_directory_path() / ("champsim-" + name + ".bpt")).string(); }
+
+std::vector<champsim::branch_record> some_branches()
+{
+  return {
+      {champsim::address{0x401000}, champsim::address{0x401800}, 3, BRANCH_CONDITIONAL, true},
+      {champsim::address{0x401804}, champsim::address{}, 1, BRANCH_CONDITIONAL, false},
+      {champsim::address{0x401810}, champsim::address{0x400000}, 5, BRANCH_DIRECT_CALL, true},
+      {champsim::address{0x400020}, champsim::address{0x401814}, 9, BRANCH_RETURN, true},
+      {champsim::address{0xffff'ffff'ffff'fff0}, champsim::address{0x10}, 2, BRANCH_INDIRECT, true},
+      {champsim::address{0x401900}, champsim::address{}, 70000, BRANCH_OTHER, false},
+  };
+}
+} // namespace
+
+TEST_CASE("A branch trace reads back the branches it was written with") {
+  auto file_name = branch_trace_path("roundtrip");
+  auto branches = some_branches();
+  {
+    champsim::branch_tracewriter writer{file_name};
+    for (const auto& branch : branches)
+      writer(branch);
+  }
+
+  champsim::branch_tracereader uut{file_name};
+  REQUIRE(uut.branches() == std::size(branches));
+  REQUIRE(uut.instructions() == 70020);
+
+  std::vector<champsim::branch_record> read_back;
+  while (!uut.eof())
+    read_back.push_back(uut());
+  REQUIRE(read_back == branches);
+
+  std::filesystem::remove(file_name);
+}
+
+TEST_CASE("A branch trace can be split into many blocks") {
+  auto file_name = branch_trace_path("blocks");
+  auto branches = some_branches();
+  {
+    champsim::branch_tracewriter writer{file_name, 4};
+    for (const auto& branch : branches)
+      writer(branch);
+  }
+
+  champsim::branch_tracereader uut{file_name};
+  std::vector<champsim::branch_record> block;
+
+  REQUIRE(uut() == branches.at(0));
+
+  // The rest of a partly read block is returned first
+  REQUIRE(uut.next_block(block));
+  REQUIRE(block == std::vector(std::next(std::begin(branches)), std::next(std::begin(branches), 4)));
+
+  REQUIRE(uut.next_block(block));
+  REQUIRE(block == std::vector(std::next(std::begin(branches), 4), std::end(branches)));
+
+  REQUIRE(uut.eof());
+  REQUIRE_FALSE(uut.next_block(block));
+
+  std::filesystem::remove(file_name);
+}
+
+TEST_CASE("A branch trace keeps only the branches of a full trace, and counts every instruction") {
+  auto file_name = branch_trace_path("extract");
+
+  input_instr nonbranch{};
+  nonbranch.ip = 0x1000;
+  input_instr jump{};
+  jump.ip = 0x1004;
+  jump.is_branch = true;
+  jump.branch_taken = true;
+  jump.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+
+  auto jump_instr = ooo_model_instr{0, jump};
+  jump_instr.branch_target = champsim::address{0x2000};
+  {
+    champsim::branch_tracewriter writer{file_name};
+    writer(ooo_model_instr{0, nonbranch});
+    writer(ooo_model_instr{0, nonbranch});
+    writer(jump_instr);
+    writer(ooo_model_instr{0, nonbranch});
+  }
+
+  champsim::branch_tracereader uut{file_name};
+  REQUIRE(uut.branches() == 1);
+  REQUIRE(uut.instructions() == 4);
+
+  auto record = uut();
+  REQUIRE(record.ip == champsim::address{0x1004});
+  REQUIRE(record.target == champsim::address{0x2000});
+  REQUIRE(record.instructions == 3);
+  REQUIRE(record.type == BRANCH_DIRECT_JUMP);
+  REQUIRE(record.taken);
+  REQUIRE(uut.eof());
+
+  auto instr = champsim::make_instr(0, record);
+  REQUIRE(instr.is_branch);
+  REQUIRE(instr.branch == BRANCH_DIRECT_JUMP);
+  REQUIRE(instr.branch_target == champsim::address{0x2000});
+
+  std::filesystem::remove(file_name);
+}
+
+TEST_CASE("A file that is not a branch trace is rejected") {
+  auto file_name = branch_trace_path("not-a-trace");
+  {
+    std::ofstream file{file_name, std::ios::binary};
+    file << "not a branch trace, but long enough to hold a header";
+  }
+
+  REQUIRE_FALSE(champsim::branch_tracereader::is_branch_trace(file_name));
+  REQUIRE_THROWS(champsim::branch_tracereader{file_name});
+
+  std::filesystem::remove(file_name);
+}
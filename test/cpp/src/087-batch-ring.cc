@@ -0,0 +1,50 @@
+#include <catch.hpp>
+
+#include <future>
+#include <numeric>
+#include <vector>
+
+#include "batch_ring.h"
+
+namespace
+{
+std::vector<int> take_all(champsim::batch_ring<std::vector<int>>& ring, std::size_t consumer)
+{
+  std::vector<int> result;
+  for (auto batch = ring.pop(consumer); batch != nullptr; batch = ring.pop(consumer))
+    result.insert(std::end(result), std::begin(*batch), std::end(*batch));
+  return result;
+}
+} // namespace
+
+TEST_CASE("Every consumer of a batch ring sees every batch in order") {
+  constexpr std::size_t num_consumers = 3;
+  constexpr int num_batches = 100;
+  champsim::batch_ring<std::vector<int>> uut{2, num_consumers};
+
+  std::vector<std::future<std::vector<int>>> consumers;
+  for (std::size_t i = 0; i < num_consumers; ++i)
+    consumers.push_back(std::async(std::launch::async, take_all, std::ref(uut), i));
+
+  for (int i = 0; i < num_batches; ++i)
+    uut.push(std::vector<int>{2 * i, 2 * i + 1});
+  uut.close();
+
+  std::vector<int> expected(2 * num_batches);
+  std::iota(std::begin(expected), std::end(expected), 0);
+  for (auto& consumer : consumers)
+    REQUIRE(consumer.get() == expected);
+}
+
+TEST_CASE("A consumer that leaves a batch ring does not hold back the producer") {
+  champsim::batch_ring<std::vector<int>> uut{1, 2};
+  auto consumer = std::async(std::launch::async, take_all, std::ref(uut), 0);
+
+  uut.leave(1);
+  for (int i = 0; i < 10; ++i)
+    uut.push(std::vector<int>{i});
+  uut.close();
+
+  REQUIRE(std::size(consumer.get()) == 10);
+  REQUIRE(uut.pop(1) == nullptr);
+}
@@ -0,0 +1,88 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include "../../../branch/meta_predictor/meta_predictor.h"
+#include "parameter_sweep.h"
+
+TEST_CASE("A sweep parameter can be parsed as a list or a range") {
+  auto list = champsim::sweep::parameter_space::parse("list", "0.5,1,2e-3");
+  REQUIRE(list.values == std::vector<double>{0.5, 1, 2e-3});
+
+  auto range = champsim::sweep::parameter_space::parse("range", "-1:0.5");
+  REQUIRE(std::empty(range.values));
+  REQUIRE(range.lower == -1);
+  REQUIRE(range.upper == 0.5);
+  REQUIRE_FALSE(range.logarithmic);
+
+  auto log_range = champsim::sweep::parameter_space::parse("log_range", "0.001:0.1:log");
+  REQUIRE(log_range.logarithmic);
+
+  REQUIRE_THROWS(champsim::sweep::parameter_space::parse("bad", "0.1,x"));
+  REQUIRE_THROWS(champsim::sweep::parameter_space::parse("bad", "1:0"));
+  REQUIRE_THROWS(champsim::sweep::parameter_space::parse("bad", "0:1:log"));
+}
+
+TEST_CASE("A grid holds every combination of the listed values") {
+  champsim::sweep::search_space space{champsim::sweep::parameter_space::parse("a", "1,2,3"), champsim::sweep::parameter_space::parse("b", "10,20")};
+  auto candidates = champsim::sweep::grid(space);
+
+  REQUIRE(std::size(candidates) == 6);
+  REQUIRE(candidates.front() == champsim::sweep::candidate{1, 10});
+  REQUIRE(candidates.back() == champsim::sweep::candidate{3, 20});
+
+  space.push_back(champsim::sweep::parameter_space::parse("c", "0:1"));
+  REQUIRE_THROWS(champsim::sweep::grid(space));
+}
+
+TEST_CASE("Random candidates are drawn from the search space, and depend only on the seed") {
+  champsim::sweep::search_space space{champsim::sweep::parameter_space::parse("list", "4,8"), champsim::sweep::parameter_space::parse("log", "0.001:0.1:log"),
+                                      champsim::sweep::parameter_space::parse("integral", "2:12")};
+  space.back().integral = true;
+
+  auto candidates = champsim::sweep::sample(space, 50, 7);
+  REQUIRE(std::size(candidates) == 50);
+  for (const auto& candidate : candidates) {
+    CHECK((candidate[0] == 4 || candidate[0] == 8));
+    CHECK(candidate[1] >= 0.001);
+    CHECK(candidate[1] <= 0.1);
+    CHECK(candidate[2] == std::round(candidate[2]));
+  }
+
+  REQUIRE(champsim::sweep::sample(space, 50, 7) == candidates);
+  REQUIRE(champsim::sweep::sample(space, 50, 8) != candidates);
+}
+
+TEST_CASE("Successive halving keeps the best candidates on longer prefixes") {
+  std::vector<champsim::sweep::candidate> candidates{{5}, {1}, {8}, {3}, {2}, {9}, {4}, {7}, {6}};
+  std::vector<long long> lengths;
+  auto evaluate = [&](const std::vector<champsim::sweep::candidate>& round, long long length) {
+    lengths.push_back(length);
+    std::vector<double> mpki;
+    for (const auto& candidate : round)
+      mpki.push_back(candidate.front());
+    return mpki;
+  };
+
+  auto results = champsim::sweep::successive_halving(candidates, champsim::sweep::halving_schedule{100, 10'000, 3}, evaluate);
+
+  // Nine candidates, then three, then the last on the full length
+  REQUIRE(lengths == std::vector<long long>{100, 300, 10'000});
+  REQUIRE(std::size(results) == std::size(candidates));
+  REQUIRE(results.at(0).parameters == champsim::sweep::candidate{1});
+  REQUIRE(results.at(0).rounds == 3);
+  REQUIRE(results.at(0).instructions == 10'000);
+  REQUIRE(results.at(1).parameters == champsim::sweep::candidate{2});
+  REQUIRE(results.at(1).rounds == 2);
+  REQUIRE(results.at(3).parameters == champsim::sweep::candidate{4});
+  REQUIRE(results.at(3).rounds == 1);
+  REQUIRE(results.back().parameters == champsim::sweep::candidate{9});
+}
+
+TEST_CASE("A meta predictor can be built with its swept parameters") {
+  meta_predictor_parameters parameters{};
+  parameters.bandit_set_bits = 6;
+  meta_predictor uut{nullptr, parameters};
+
+  REQUIRE(uut.bandits().num_sets() == 64);
+}
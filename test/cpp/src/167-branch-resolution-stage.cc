@@ -0,0 +1,101 @@
+#include <catch.hpp>
+
+#include <map>
+#include <vector>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "mocks.hpp"
+#include "ooo_cpu.h"
+#include "instr.h"
+
+namespace
+{
+  std::map<O3_CPU*, std::vector<champsim::modules::branch_predictor::prediction_id>> predicted_ids;
+  std::map<O3_CPU*, std::vector<champsim::modules::branch_predictor::prediction_id>> resolved_ids;
+  std::map<O3_CPU*, std::vector<champsim::modules::branch_predictor::prediction_id>> repaired_ids;
+
+  struct recording_predictor : champsim::modules::branch_predictor
+  {
+    using branch_predictor::branch_predictor;
+
+    bool predict_branch(prediction_id id, champsim::address, champsim::address, bool, uint8_t)
+    {
+      ::predicted_ids[intern_].push_back(id);
+      return false;
+    }
+
+    void last_branch_result(prediction_id id, champsim::address, champsim::address, bool, uint8_t)
+    {
+      ::resolved_ids[intern_].push_back(id);
+    }
+
+    void repair_branch_history(prediction_id id, champsim::address, champsim::address, bool, uint8_t)
+    {
+      ::repaired_ids[intern_].push_back(id);
+    }
+  };
+}
+
+SCENARIO("A branch is resolved at the configured stage with the identifier of its prediction") {
+  GIVEN("A core with a single branch instruction") {
+    auto stage = GENERATE(champsim::branch_resolution_stage::fetch, champsim::branch_resolution_stage::execute, champsim::branch_resolution_stage::retire);
+    do_nothing_MRC mock_L1I, mock_L1D, mock_L2C;
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}
+      .name("167-l1i")
+      .lower_level(&mock_L2C.queues)
+    };
+    O3_CPU uut{champsim::core_builder{}
+      .ifetch_buffer_size(16)
+      .decode_buffer_size(16)
+      .dispatch_buffer_size(16)
+      .register_file_size(128)
+      .rob_size(16)
+      .l1i(&l1i)
+      .fetch_queues(&mock_L1I.queues)
+      .data_queues(&mock_L1D.queues)
+      .branch_resolution(stage)
+      .branch_predictor<recording_predictor>()
+    };
+    uut.warmup = false;
+
+    ::predicted_ids[&uut].clear();
+    ::resolved_ids[&uut].clear();
+    ::repaired_ids[&uut].clear();
+    auto branch = champsim::test::branch_instruction_with_ip(0xdeadbeef);
+    branch.branch_target = champsim::address{0xcafebabe}; // the empty BTB cannot predict this, so the branch is mispredicted
+    uut.input_queue.push_back(branch);
+
+    WHEN("The branch is predicted") {
+      for (auto op : std::array<champsim::operable*,3>{{&uut, &mock_L1I, &mock_L1D}})
+        op->_operate();
+
+      THEN("It is resolved only if branches are resolved at fetch") {
+        REQUIRE(std::size(::predicted_ids[&uut]) == 1);
+        REQUIRE(std::empty(::resolved_ids[&uut]) == (stage != champsim::branch_resolution_stage::fetch));
+      }
+    }
+
+    WHEN("The branch is simulated until it retires") {
+      bool resolved_before_retire = false;
+      for (int i = 0; i < 1000 && uut.num_retired < 1; ++i) {
+        resolved_before_retire = !std::empty(::resolved_ids[&uut]);
+        for (auto op : std::array<champsim::operable*,3>{{&uut, &mock_L1I, &mock_L1D}})
+          op->_operate();
+      }
+
+      THEN("It is resolved exactly once, with the identifier it was predicted with") {
+        REQUIRE(uut.num_retired == 1);
+        REQUIRE(::resolved_ids[&uut] == ::predicted_ids[&uut]);
+      }
+
+      THEN("It is resolved before the cycle it retires unless branches are resolved at retire") {
+        REQUIRE(resolved_before_retire == (stage != champsim::branch_resolution_stage::retire));
+      }
+
+      THEN("The history of its misprediction is repaired exactly once, whatever the stage it is resolved at") {
+        REQUIRE(::repaired_ids[&uut] == ::predicted_ids[&uut]);
+      }
+    }
+  }
+}
@@ -73,3 +73,17 @@ TEST_CASE("After saturating taken, the bimodal predictor predicts not taken afte
   uut.last_branch_result(ip_under_test, champsim::address{}, false, 0);
   REQUIRE_FALSE(uut.predict_branch(ip_under_test));
 }
+
+TEST_CASE("The bimodal predictor is confident once its counter saturates") {
+  bimodal uut{nullptr};
+  champsim::address ip_under_test{0xdeadbeef};
+
+  uut.last_branch_result(ip_under_test, champsim::address{}, true, 0);
+  uut.last_branch_result(ip_under_test, champsim::address{}, true, 0);
+  REQUIRE(uut.predict_branch(ip_under_test));
+  REQUIRE(uut.prediction_confidence() == 0.0f);
+
+  uut.last_branch_result(ip_under_test, champsim::address{}, true, 0);
+  REQUIRE(uut.predict_branch(ip_under_test));
+  REQUIRE(uut.prediction_confidence() == 1.0f);
+}
@@ -1,5 +1,8 @@
 #include <catch.hpp>
 
+#include <deque>
+#include <random>
+
 #include "../../../branch/hashed_perceptron/folded_shift_register.h"
 
 using global_history = folded_shift_register<champsim::data::bits{12}>;
@@ -151,3 +154,24 @@ TEST_CASE("The global history folds twice") {
 
   REQUIRE(ghist.value() == evaluated);
 }
+
+TEST_CASE("The incrementally folded global history matches folding the whole history") {
+  auto length = GENERATE(1u, 3u, 11u, 12u, 13u, 60u, 125u, 232u);
+  global_history ghist{champsim::data::bits{length}};
+  std::deque<bool> history(length, false);
+
+  std::mt19937_64 rng{length};
+  for (int i = 0; i < 1000; ++i) {
+    const auto taken = (rng() % 3) != 0;
+    ghist.push_back(taken);
+    history.push_front(taken);
+    history.pop_back();
+
+    std::size_t evaluated = 0;
+    for (std::size_t j = 0; j < length; ++j)
+      evaluated ^= (history[j] ? 1ull : 0ull) << (j % 12);
+
+    INFO("Length: " << length << ", pushes: " << i + 1);
+    REQUIRE(ghist.value() == evaluated);
+  }
+}
@@ -0,0 +1,86 @@
+#include <catch.hpp>
+
+#include "../../../branch/meta_predictor/bandit_table.h"
+
+namespace
+{
+struct counting_bandit {
+  int updates = 0;
+};
+} // namespace
+
+TEST_CASE("A bandit table returns the same entry for the same branch") {
+  BanditTable<counting_bandit> uut{16, 2, 12, counting_bandit{}};
+  champsim::address ip{0xdeadbeef};
+
+  uut.lookup(ip).updates++;
+  uut.lookup(champsim::address{0xcafebabe});
+
+  REQUIRE(uut.lookup(ip).updates == 1);
+  CHECK(uut.misses() == 2);
+  CHECK(uut.evictions() == 0);
+}
+
+TEST_CASE("A bandit table evicts the least-recently-used way and resets its bandit") {
+  BanditTable<counting_bandit> uut{1, 2, 12, counting_bandit{}};
+  champsim::address first{0x100};
+  champsim::address second{0x200};
+  champsim::address third{0x300};
+
+  uut.lookup(first).updates++;
+  uut.lookup(second).updates++;
+  uut.lookup(first);
+  uut.lookup(third);
+  CHECK(uut.evictions() == 1);
+
+  REQUIRE(uut.lookup(first).updates == 1);
+  REQUIRE(uut.lookup(second).updates == 0);
+}
+
+TEST_CASE("A bandit table never holds more entries than sets times ways") {
+  BanditTable<counting_bandit> uut{4, 2, 12, counting_bandit{}};
+
+  for (uint64_t i = 0; i < 1000; ++i)
+    uut.lookup(champsim::address{i << 8});
+
+  REQUIRE(uut.misses() - uut.evictions() <= 8);
+}
+
+TEST_CASE("A bandit table counts branches that share a partial tag as aliases") {
+  BanditTable<counting_bandit> uut{1, 4, 4, counting_bandit{}};
+  champsim::address first{0x15};
+  champsim::address second{0x115}; // differs only above the 4 tag bits
+
+  uut.lookup(first).updates++;
+  REQUIRE(uut.lookup(second).updates == 1);
+  REQUIRE(uut.aliases() == 1);
+}
+
+TEST_CASE("A bandit table reports whether its last lookup allocated the entry") {
+  BanditTable<counting_bandit> uut{1, 1, 12, counting_bandit{}};
+  champsim::address first{0x100};
+  champsim::address second{0x200};
+
+  uut.lookup(first);
+  CHECK(uut.last_allocated());
+  uut.lookup(first);
+  CHECK_FALSE(uut.last_allocated());
+  uut.lookup(second);
+  CHECK(uut.last_allocated());
+  uut.lookup(first);
+  CHECK(uut.last_allocated());
+}
+
+TEST_CASE("A bandit table does not count a repeated lookup as another access") {
+  BanditTable<counting_bandit> uut{1, 2, 4, counting_bandit{}};
+  champsim::address first{0x15};
+  champsim::address second{0x115}; // differs only above the 4 tag bits
+
+  uut.lookup(first);
+  uut.lookup(second);
+  uut.lookup(second);
+
+  CHECK(uut.misses() == 1);
+  CHECK(uut.hits() == 1);
+  CHECK(uut.aliases() == 1);
+}
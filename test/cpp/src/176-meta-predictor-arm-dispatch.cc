@@ -0,0 +1,312 @@
+#include <catch.hpp>
+#include <array>
+#include <vector>
+
+#include "../../../branch/meta_predictor/basic_meta_predictor.h"
+
+namespace
+{
+template <bool PREDICTION>
+struct fixed_arm : champsim::modules::branch_predictor {
+  using branch_predictor::branch_predictor;
+  int predictions = 0;
+  int updates = 0;
+  bool predict_branch(champsim::address) { ++predictions; return PREDICTION; }
+  void last_branch_result(champsim::address, champsim::address, bool, uint8_t) { ++updates; }
+};
+
+struct pinned_bandit {
+  using reward_type = double;
+  struct state_type {
+  };
+
+  int arm = 0;
+  static reward_type make_reward(double reward) { return reward; }
+  int select_arm(state_type&) const { return arm; }
+  void update(state_type&, int, reward_type) const {}
+};
+
+// Remembers the last reward given to each arm
+struct recording_bandit {
+  using reward_type = double;
+  struct state_type {
+  };
+
+  std::array<double, 3>* rewards;
+  static reward_type make_reward(double reward) { return reward; }
+  int select_arm(state_type&) const { return 0; }
+  void update(state_type&, int arm, reward_type reward) const { rewards->at(static_cast<std::size_t>(arm)) = reward; }
+};
+
+using dispatch_uut = basic_meta_predictor<pinned_bandit, fixed_arm<false>, fixed_arm<true>, fixed_arm<false>>;
+} // namespace
+
+TEST_CASE("A meta predictor uses the prediction of the arm its bandit selects") {
+  auto arm = GENERATE(0, 1, 2);
+  dispatch_uut uut{nullptr, 1, 1, 12, pinned_bandit{arm}};
+
+  REQUIRE(uut.predict_branch(champsim::address{0xdeadbeef}) == (arm == 1));
+}
+
+TEST_CASE("A meta predictor only predicts with and trains the selected arm") {
+  dispatch_uut uut{nullptr, 1, 1, 12, pinned_bandit{2}};
+  champsim::address ip{0xdeadbeef};
+
+  uut.predict_branch(ip);
+  uut.last_branch_result(ip, champsim::address{}, true, 0);
+
+  CHECK(uut.arm<0>().predictions == 0);
+  CHECK(uut.arm<1>().predictions == 0);
+  CHECK(uut.arm<2>().predictions == 1);
+  CHECK(uut.arm<0>().updates == 0);
+  CHECK(uut.arm<1>().updates == 0);
+  CHECK(uut.arm<2>().updates == 1);
+}
+
+TEST_CASE("A meta predictor in shadow mode predicts with and trains every arm") {
+  dispatch_uut uut{nullptr, 1, 1, 12, pinned_bandit{2}, meta_training_mode::shadow};
+  champsim::address ip{0xdeadbeef};
+
+  REQUIRE_FALSE(uut.predict_branch(ip));
+  uut.last_branch_result(ip, champsim::address{}, true, 0);
+
+  CHECK(uut.arm<0>().predictions == 1);
+  CHECK(uut.arm<1>().predictions == 1);
+  CHECK(uut.arm<2>().predictions == 1);
+  CHECK(uut.arm<0>().updates == 1);
+  CHECK(uut.arm<1>().updates == 1);
+  CHECK(uut.arm<2>().updates == 1);
+}
+
+TEST_CASE("A meta predictor in shadow mode rewards each arm for its own prediction") {
+  std::array<double, 3> rewards{};
+  basic_meta_predictor<recording_bandit, fixed_arm<false>, fixed_arm<true>, fixed_arm<false>> uut{nullptr, 1, 1, 12, recording_bandit{&rewards},
+                                                                                                  meta_training_mode::shadow};
+  champsim::address ip{0xdeadbeef};
+
+  uut.predict_branch(ip);
+  uut.last_branch_result(ip, champsim::address{}, true, 0);
+
+  CHECK(rewards[0] == -0.5);
+  CHECK(rewards[1] == 1.0);
+  CHECK(rewards[2] == -0.5);
+}
+
+TEST_CASE("A meta predictor in oracle mode predicts with its bandit and measures the oracle") {
+  dispatch_uut uut{nullptr, 1, 1, 12, pinned_bandit{2}, meta_training_mode::oracle};
+  champsim::address ip{0xdeadbeef};
+
+  REQUIRE_FALSE(uut.predict_branch(ip));
+  uut.last_branch_result(ip, champsim::address{}, true, 0);
+
+  CHECK(uut.arm<0>().predictions == 1);
+  CHECK(uut.arm<1>().predictions == 1);
+  CHECK(uut.arm<2>().predictions == 1);
+  CHECK(uut.arm<0>().updates == 1);
+  CHECK(uut.arm<1>().updates == 1);
+  CHECK(uut.arm<2>().updates == 1);
+
+  auto stats = uut.meta_predictor_telemetry();
+  CHECK(stats.oracle_branches == 1);
+  CHECK(stats.chooser_correct == 0);
+  CHECK(stats.oracle_correct == 1);
+  CHECK(stats.static_best_correct == 1);
+}
+
+namespace
+{
+// Votes with a fixed arm, and remembers what it was trained with
+struct recording_vote {
+  using reward_type = double;
+  struct state_type {
+  };
+
+  std::size_t arm = 0;
+  std::array<bool, 3> last_predictions{};
+  bool last_taken = false;
+
+  static reward_type make_reward(double reward) { return reward; }
+  bool vote(state_type&, const std::array<bool, 3>& predictions) const { return predictions.at(arm); }
+  void update_votes(state_type&, const std::array<bool, 3>& predictions, bool taken)
+  {
+    last_predictions = predictions;
+    last_taken = taken;
+  }
+};
+} // namespace
+
+TEST_CASE("A meta predictor with a voting policy predicts with the vote and trains every arm") {
+  basic_meta_predictor<recording_vote, fixed_arm<false>, fixed_arm<true>, fixed_arm<false>> uut{nullptr, 1, 1, 12, recording_vote{1}};
+  champsim::address ip{0xdeadbeef};
+
+  REQUIRE(uut.predict_branch(ip));
+  uut.last_branch_result(ip, champsim::address{}, false, 0);
+
+  CHECK(uut.arm<0>().predictions == 1);
+  CHECK(uut.arm<1>().predictions == 1);
+  CHECK(uut.arm<2>().predictions == 1);
+  CHECK(uut.arm<0>().updates == 1);
+  CHECK(uut.arm<1>().updates == 1);
+  CHECK(uut.arm<2>().updates == 1);
+}
+
+namespace
+{
+// Remembers the identifiers of the branches it predicted and was trained with
+template <bool PREDICTION>
+struct tagged_arm : champsim::modules::branch_predictor {
+  using branch_predictor::branch_predictor;
+  std::vector<prediction_id> predicted{};
+  std::vector<prediction_id> resolved{};
+  bool predict_branch(prediction_id id, champsim::address)
+  {
+    predicted.push_back(id);
+    return PREDICTION;
+  }
+  void last_branch_result(prediction_id id, champsim::address, champsim::address, bool, uint8_t) { resolved.push_back(id); }
+};
+
+// Selects each arm in turn, and remembers the last reward given to each arm
+struct round_robin_bandit {
+  using reward_type = double;
+  struct state_type {
+  };
+
+  int* next;
+  std::array<double, 3>* rewards;
+  static reward_type make_reward(double reward) { return reward; }
+  int select_arm(state_type&) const { return (*next)++ % 3; }
+  void update(state_type&, int arm, reward_type reward) const { rewards->at(static_cast<std::size_t>(arm)) = reward; }
+};
+} // namespace
+
+TEST_CASE("A meta predictor resolves branches out of order with the arm that predicted each") {
+  int next = 0;
+  std::array<double, 3> rewards{};
+  basic_meta_predictor<round_robin_bandit, tagged_arm<false>, tagged_arm<true>, tagged_arm<false>> uut{nullptr, 1, 1, 12,
+                                                                                                      round_robin_bandit{&next, &rewards}};
+  champsim::address ip{0xdeadbeef};
+
+  CHECK_FALSE(uut.predict_branch(10, ip, champsim::address{}, false, BRANCH_CONDITIONAL));
+  CHECK(uut.predict_branch(11, ip, champsim::address{}, false, BRANCH_CONDITIONAL));
+  CHECK_FALSE(uut.predict_branch(12, ip, champsim::address{}, false, BRANCH_CONDITIONAL));
+
+  uut.last_branch_result(12, ip, champsim::address{}, true, 0);
+  uut.last_branch_result(10, ip, champsim::address{}, true, 0);
+  uut.last_branch_result(11, ip, champsim::address{}, true, 0);
+
+  CHECK(uut.arm<0>().predicted == std::vector<champsim::modules::branch_predictor::prediction_id>{10});
+  CHECK(uut.arm<1>().predicted == std::vector<champsim::modules::branch_predictor::prediction_id>{11});
+  CHECK(uut.arm<2>().predicted == std::vector<champsim::modules::branch_predictor::prediction_id>{12});
+  CHECK(uut.arm<0>().resolved == std::vector<champsim::modules::branch_predictor::prediction_id>{10});
+  CHECK(uut.arm<1>().resolved == std::vector<champsim::modules::branch_predictor::prediction_id>{11});
+  CHECK(uut.arm<2>().resolved == std::vector<champsim::modules::branch_predictor::prediction_id>{12});
+
+  CHECK(rewards[0] == -0.5);
+  CHECK(rewards[1] == 1.0);
+  CHECK(rewards[2] == -0.5);
+}
+
+TEST_CASE("A meta predictor ignores the resolution of a branch it did not predict") {
+  int next = 0;
+  std::array<double, 3> rewards{};
+  basic_meta_predictor<round_robin_bandit, tagged_arm<false>, tagged_arm<true>, tagged_arm<false>> uut{nullptr, 1, 1, 12,
+                                                                                                      round_robin_bandit{&next, &rewards}};
+  champsim::address ip{0xdeadbeef};
+
+  uut.predict_branch(10, ip, champsim::address{}, false, BRANCH_CONDITIONAL);
+  uut.last_branch_result(10, ip, champsim::address{}, true, 0);
+  uut.last_branch_result(10, ip, champsim::address{}, true, 0);
+
+  CHECK(uut.arm<0>().resolved.size() == 1);
+  CHECK(uut.arm<1>().resolved.empty());
+  CHECK(uut.arm<2>().resolved.empty());
+}
+
+namespace
+{
+// Reports a fixed confidence, in percent, in each of its predictions
+template <bool PREDICTION, int CONFIDENCE>
+struct confident_arm : fixed_arm<PREDICTION> {
+  using fixed_arm<PREDICTION>::fixed_arm;
+  float prediction_confidence() const { return static_cast<float>(CONFIDENCE) / 100.0f; }
+};
+
+// Chooses arm 0, with fixed value estimates
+struct valued_bandit {
+  using reward_type = double;
+  struct state_type {
+  };
+
+  std::array<double, 3> values{};
+  static reward_type make_reward(double reward) { return reward; }
+  int select_arm(state_type&) const { return 0; }
+  void update(state_type&, int, reward_type) const {}
+  reward_type value(const state_type&, int arm) const { return values.at(static_cast<std::size_t>(arm)); }
+};
+} // namespace
+
+TEST_CASE("A meta predictor with confidence rewards scales each arm's reward by its confidence") {
+  std::array<double, 3> rewards{};
+  basic_meta_predictor<recording_bandit, confident_arm<false, 0>, confident_arm<true, 100>, confident_arm<false, 100>> uut{
+      nullptr, 1, 1, 12, recording_bandit{&rewards}, meta_training_mode::shadow};
+  uut.set_confidence_rewards(true);
+  champsim::address ip{0xdeadbeef};
+
+  uut.predict_branch(ip);
+  uut.last_branch_result(ip, champsim::address{}, true, 0);
+
+  CHECK(rewards[0] == -0.25);
+  CHECK(rewards[1] == 1.0);
+  CHECK(rewards[2] == -0.5);
+}
+
+TEST_CASE("A meta predictor with confidence selection prefers the most confident arm of those with close values") {
+  using uut_type = basic_meta_predictor<valued_bandit, confident_arm<false, 0>, confident_arm<true, 50>, confident_arm<false, 100>>;
+  auto mode = GENERATE(meta_training_mode::chosen_arm, meta_training_mode::shadow);
+  uut_type uut{nullptr, 1, 1, 12, valued_bandit{{0.0, 0.1, 0.5}}, mode};
+  uut.set_confidence_selection(true);
+
+  // Arm 2 is the most confident, but its value is not close to that of arm 0. Only every arm's confidence can be compared.
+  REQUIRE(uut.predict_branch(champsim::address{0xdeadbeef}) == (mode == meta_training_mode::shadow));
+}
+
+TEST_CASE("A meta predictor in gated mode stops predicting with and training dominated arms") {
+  dispatch_uut uut{nullptr, 1, 1, 12, pinned_bandit{0}, meta_training_mode::gated};
+  champsim::address ip{0xdeadbeef};
+
+  for (int i = 0; i < 100; ++i) {
+    uut.predict_branch(ip);
+    uut.last_branch_result(ip, champsim::address{}, true, 0);
+  }
+
+  // the bandit's choice is gated, so the leading arm predicts in its place
+  REQUIRE(uut.predict_branch(ip));
+  uut.last_branch_result(ip, champsim::address{}, true, 0);
+
+  CHECK(uut.arm<0>().predictions < 50);
+  CHECK(uut.arm<1>().predictions == 101);
+  CHECK(uut.arm<2>().predictions < 50);
+  CHECK(uut.arm<0>().updates == uut.arm<0>().predictions);
+  CHECK(uut.arm<2>().updates == uut.arm<2>().predictions);
+
+  auto stats = uut.meta_predictor_telemetry();
+  CHECK(stats.gated_branches == 101);
+  CHECK(stats.gated_evaluations == static_cast<uint64_t>(uut.arm<0>().predictions + uut.arm<1>().predictions + uut.arm<2>().predictions));
+  CHECK(stats.arms_gated == 2);
+}
+
+TEST_CASE("A meta predictor leaves its bandit table and arms untouched for non-branches") {
+  auto mode = GENERATE(meta_training_mode::chosen_arm, meta_training_mode::shadow, meta_training_mode::oracle, meta_training_mode::gated);
+  dispatch_uut uut{nullptr, 1, 2, 12, pinned_bandit{1}, mode};
+
+  for (uint64_t i = 0; i < 100; ++i)
+    REQUIRE_FALSE(uut.predict_branch(i, champsim::address{0x1000 + 4 * i}, champsim::address{}, false, NOT_BRANCH));
+
+  CHECK(uut.bandits().hits() == 0);
+  CHECK(uut.bandits().misses() == 0);
+  CHECK(uut.bandits().evictions() == 0);
+  CHECK(uut.arm<0>().predictions == 0);
+  CHECK(uut.arm<1>().predictions == 0);
+  CHECK(uut.arm<2>().predictions == 0);
+}
@@ -0,0 +1,96 @@
+#include <catch.hpp>
+
+#include "../../../branch/meta_predictor/fixed_point_bandit.h"
+
+TEMPLATE_TEST_CASE("A fixed-point bandit tries every arm before exploiting", "", FixedPointEpsilonGreedyBandit<4>, FixedPointUCB1Bandit<4>) {
+  TestType uut{};
+  typename TestType::state_type state{};
+
+  for (int arm = 0; arm < 4; ++arm) {
+    REQUIRE(uut.select_arm(state) == arm);
+    uut.update(state, arm, TestType::make_reward(-0.5));
+  }
+}
+
+TEMPLATE_TEST_CASE("A fixed-point bandit settles on the arm with the best reward", "", FixedPointEpsilonGreedyBandit<4>, FixedPointUCB1Bandit<4>) {
+  TestType uut{};
+  typename TestType::state_type state{};
+  const auto good = TestType::make_reward(1.0);
+  const auto bad = TestType::make_reward(-0.5);
+
+  for (int i = 0; i < 20000; ++i) {
+    auto arm = uut.select_arm(state);
+    uut.update(state, arm, arm == 2 ? good : bad);
+  }
+
+  int chose_best = 0;
+  for (int i = 0; i < 1000; ++i) {
+    auto arm = uut.select_arm(state);
+    chose_best += (arm == 2);
+    uut.update(state, arm, arm == 2 ? good : bad);
+  }
+  REQUIRE(chose_best > 950);
+}
+
+TEST_CASE("The fixed-point running mean equals the reward after the first update") {
+  FixedPointEpsilonGreedyBandit<2> uut{};
+  FixedPointEpsilonGreedyBandit<2>::state_type state{};
+
+  uut.update(state, 1, FixedPointEpsilonGreedyBandit<2>::make_reward(-0.5));
+  REQUIRE(state.values[1] == FixedPointEpsilonGreedyBandit<2>::make_reward(-0.5));
+}
+
+TEST_CASE("Logarithmic count buckets are exact for small counts and monotonic") {
+  using namespace fixed_point_bandit_detail;
+  for (uint32_t i = 0; i < 16; ++i)
+    CHECK(log_bucket(i) == i);
+
+  std::size_t last = 0;
+  for (uint32_t x = 1; x < (1u << 20); x += 997) {
+    auto bucket = log_bucket(x);
+    REQUIRE(bucket >= last);
+    REQUIRE(bucket < LOG_BUCKETS);
+    last = bucket;
+  }
+  REQUIRE(log_bucket(std::numeric_limits<uint32_t>::max()) < LOG_BUCKETS);
+}
+
+TEMPLATE_TEST_CASE("A fixed-point running mean converges to a constant reward from either side", "", FixedPointEpsilonGreedyBandit<2>, FixedPointUCB1Bandit<2>) {
+  TestType uut{};
+  typename TestType::state_type state{};
+  const auto one = TestType::make_reward(1.0);
+  const auto zero = TestType::make_reward(0.0);
+  const auto tolerance = TestType::make_reward(0.01);
+
+  // The first update sets the value to the opposite reward, so every later step must climb or fall
+  uut.update(state, 0, zero);
+  uut.update(state, 1, one);
+  for (int i = 0; i < 1000; ++i) {
+    uut.update(state, 0, one);
+    uut.update(state, 1, zero);
+  }
+
+  CHECK(state.values[0] <= one);
+  CHECK(state.values[0] >= one - tolerance);
+  CHECK(state.values[1] >= zero);
+  CHECK(state.values[1] <= zero + tolerance);
+}
+
+TEMPLATE_TEST_CASE("A fixed-point running mean tracks the rate of a mixed reward once its counts saturate", "", FixedPointEpsilonGreedyBandit<2>, FixedPointUCB1Bandit<2>) {
+  TestType uut{};
+  typename TestType::state_type state{};
+  const auto one = TestType::make_reward(1.0);
+  const auto zero = TestType::make_reward(0.0);
+  const auto tolerance = TestType::make_reward(0.02);
+
+  // Arm 0 is rewarded 11 times in 20, and arm 1 18 times in 20, well past the largest count
+  for (int i = 0; i < 100000; ++i) {
+    uut.update(state, 0, (i % 20 < 11) ? one : zero);
+    uut.update(state, 1, (i % 20 < 18) ? one : zero);
+  }
+
+  CHECK(state.values[0] >= TestType::make_reward(0.55) - tolerance);
+  CHECK(state.values[0] <= TestType::make_reward(0.55) + tolerance);
+  CHECK(state.values[1] >= TestType::make_reward(0.9) - tolerance);
+  CHECK(state.values[1] <= TestType::make_reward(0.9) + tolerance);
+}
@@ -0,0 +1,58 @@
+#include <catch.hpp>
+
+#include "../../../branch/meta_predictor_thompson/meta_predictor_thompson.h"
+
+TEST_CASE("A Thompson sampling bandit settles on the arm with the best reward") {
+  ThompsonSamplingBandit<4> uut{};
+  ThompsonSamplingBandit<4>::state_type state{};
+  const auto good = ThompsonSamplingBandit<4>::make_reward(1.0);
+  const auto bad = ThompsonSamplingBandit<4>::make_reward(-0.5);
+
+  for (int i = 0; i < 2000; ++i) {
+    auto arm = uut.select_arm(state);
+    uut.update(state, arm, arm == 2 ? good : bad);
+  }
+
+  int chose_best = 0;
+  for (int i = 0; i < 1000; ++i) {
+    auto arm = uut.select_arm(state);
+    chose_best += (arm == 2);
+    uut.update(state, arm, arm == 2 ? good : bad);
+  }
+  REQUIRE(chose_best > 950);
+}
+
+TEST_CASE("A Thompson sampling bandit keeps exploring arms that are nearly as good") {
+  ThompsonSamplingBandit<2> uut{};
+  ThompsonSamplingBandit<2>::state_type state{};
+  state.successes = {{90, 88}};
+  state.failures = {{10, 12}};
+
+  int chose_second = 0;
+  for (int i = 0; i < 1000; ++i)
+    chose_second += (uut.select_arm(state) == 1);
+  REQUIRE(chose_second > 100);
+  REQUIRE(chose_second < 500);
+}
+
+TEST_CASE("Two Thompson sampling bandits with the same seed make the same choices") {
+  ThompsonSamplingBandit<4> lhs{42};
+  ThompsonSamplingBandit<4> rhs{42};
+  ThompsonSamplingBandit<4>::state_type state{};
+  state.successes = {{5, 6, 7, 8}};
+  state.failures = {{5, 4, 3, 2}};
+
+  for (int i = 0; i < 100; ++i)
+    REQUIRE(lhs.select_arm(state) == rhs.select_arm(state));
+}
+
+TEST_CASE("A Thompson sampling bandit halves its counts instead of saturating") {
+  ThompsonSamplingBandit<1> uut{};
+  ThompsonSamplingBandit<1>::state_type state{};
+  state.successes = {{std::numeric_limits<uint16_t>::max()}};
+  state.failures = {{100}};
+
+  uut.update(state, 0, ThompsonSamplingBandit<1>::make_reward(1.0));
+  CHECK(state.successes[0] == std::numeric_limits<uint16_t>::max() / 2 + 1);
+  CHECK(state.failures[0] == 50);
+}
@@ -0,0 +1,133 @@
+#include <catch.hpp>
+
+#include <array>
+#include <random>
+
+#include "../../../branch/meta_predictor/nonstationary_bandit.h"
+#include "msl/xoshiro.h"
+
+namespace
+{
+// Run the bandit for some number of updates where only one arm is rewarded, and count how often it was chosen
+template <typename Bandit>
+int run_phase(Bandit& uut, typename Bandit::state_type& state, int best_arm, int updates)
+{
+  const auto good = Bandit::make_reward(1.0);
+  const auto bad = Bandit::make_reward(-0.5);
+
+  int chose_best = 0;
+  for (int i = 0; i < updates; ++i) {
+    auto arm = uut.select_arm(state);
+    chose_best += (arm == best_arm);
+    uut.update(state, arm, arm == best_arm ? good : bad);
+  }
+  return chose_best;
+}
+
+// As above, but each arm is correct with its own probability
+template <typename Bandit>
+int run_phase(Bandit& uut, typename Bandit::state_type& state, std::array<double, 4> accuracy, int best_arm, int updates)
+{
+  const auto good = Bandit::make_reward(1.0);
+  const auto bad = Bandit::make_reward(-0.5);
+  champsim::msl::xoshiro256starstar rng{};
+  std::uniform_real_distribution<double> coin{};
+
+  int chose_best = 0;
+  for (int i = 0; i < updates; ++i) {
+    auto arm = uut.select_arm(state);
+    chose_best += (arm == best_arm);
+    uut.update(state, arm, coin(rng) < accuracy.at(static_cast<std::size_t>(arm)) ? good : bad);
+  }
+  return chose_best;
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("A non-stationary bandit tries every arm before exploiting", "", FixedPointDiscountedUCBBandit<4>, FixedPointSlidingWindowUCBBandit<4>) {
+  TestType uut{};
+  typename TestType::state_type state{};
+
+  for (int arm = 0; arm < 4; ++arm) {
+    REQUIRE(uut.select_arm(state) == arm);
+    uut.update(state, arm, TestType::make_reward(-0.5));
+  }
+}
+
+TEMPLATE_TEST_CASE("A non-stationary bandit settles on the arm with the best reward", "", FixedPointDiscountedUCBBandit<4>,
+                   FixedPointSlidingWindowUCBBandit<4>) {
+  TestType uut{};
+  typename TestType::state_type state{};
+
+  run_phase(uut, state, 2, 20000);
+  REQUIRE(run_phase(uut, state, 2, 1000) > 850);
+}
+
+TEMPLATE_TEST_CASE("A non-stationary bandit recovers after the best arm changes", "", FixedPointDiscountedUCBBandit<4>, FixedPointSlidingWindowUCBBandit<4>) {
+  TestType uut{};
+  typename TestType::state_type state{};
+
+  // The old best arm becomes worse than the new best arm is, but its lifetime mean stays above it
+  run_phase(uut, state, {{0.5, 0.5, 1.0, 0.5}}, 2, 100000);
+  run_phase(uut, state, {{0.9, 0.5, 0.5, 0.5}}, 0, 3000);
+  REQUIRE(run_phase(uut, state, {{0.9, 0.5, 0.5, 0.5}}, 0, 1000) > 700);
+}
+
+TEST_CASE("A sliding-window bandit forgets rewards older than its window") {
+  using uut_type = FixedPointSlidingWindowUCBBandit<2, 8>;
+  uut_type uut{};
+  uut_type::state_type state{};
+  const auto one = 1 << uut_type::STORED_FRACTION_BITS;
+
+  for (int i = 0; i < 8; ++i)
+    uut.update(state, 0, uut_type::make_reward(1.0));
+  REQUIRE(state.counts[0] == 8);
+
+  for (int i = 0; i < 8; ++i)
+    uut.update(state, 1, uut_type::make_reward(-0.5));
+  CHECK(state.counts[0] == 0);
+  CHECK(state.reward_sums[0] == 0);
+  CHECK(state.counts[1] == 8);
+  CHECK(state.reward_sums[1] == -4 * one);
+}
+
+TEST_CASE("A sliding-window bandit values each arm by the mean of its rewards in the window") {
+  using uut_type = FixedPointSlidingWindowUCBBandit<2, 8>;
+  uut_type uut{};
+  uut_type::state_type state{};
+
+  CHECK(uut.value(state, 0) == 0);
+  for (int i = 0; i < 4; ++i) {
+    uut.update(state, 0, uut_type::make_reward(1.0));
+    uut.update(state, 0, uut_type::make_reward(-0.5));
+  }
+  CHECK(uut.value(state, 0) == uut_type::make_reward(0.25));
+
+  for (int i = 0; i < 8; ++i)
+    uut.update(state, 1, uut_type::make_reward(-0.5));
+  CHECK(uut.value(state, 0) == 0);
+  CHECK(uut.value(state, 1) == uut_type::make_reward(-0.5));
+}
+
+TEST_CASE("A discounted bandit bounds its counts by the discount horizon") {
+  FixedPointDiscountedUCBBandit<1> uut{0.75};
+  FixedPointDiscountedUCBBandit<1>::state_type state{};
+
+  for (int i = 0; i < 1000; ++i)
+    uut.update(state, 0, 0);
+  REQUIRE((state.counts[0] >> FixedPointDiscountedUCBBandit<1>::COUNT_FRACTION_BITS) <= 4);
+}
+
+TEST_CASE("A discounted bandit decays a single pull geometrically") {
+  using uut_type = FixedPointDiscountedUCBBandit<2>;
+  uut_type uut{0.999};
+  uut_type::state_type state{};
+
+  uut.update(state, 0, uut_type::make_reward(1.0));
+  for (int k = 1; k <= 1024; ++k) {
+    uut.update(state, 1, uut_type::make_reward(1.0));
+    if (k % 256 == 0) {
+      const auto pulls = std::ldexp(static_cast<double>(state.counts[0]), -uut_type::COUNT_FRACTION_BITS);
+      CHECK(pulls == Approx(std::pow(0.999, k)).epsilon(0.01));
+    }
+  }
+}
@@ -0,0 +1,93 @@
+#include <catch.hpp>
+
+#include <cstdlib>
+
+#include "../../../branch/meta_predictor_linucb/meta_predictor_linucb.h"
+
+TEST_CASE("A LinUCB bandit fits its weights by least squares") {
+  using uut_type = LinUCBBandit<1, 2>;
+  uut_type uut{};
+  uut_type::state_type state{};
+  const auto tolerance = uut_type::make_reward(0.01);
+
+  for (int n = 0; n < 1000; ++n) {
+    uut.set_context({{1, 1}});
+    uut.update(state, 0, uut_type::make_reward(1.0));
+    uut.set_context({{1, -1}});
+    uut.update(state, 0, uut_type::make_reward(-0.5));
+  }
+
+  CHECK(std::abs(state.theta[0][0] - uut_type::make_reward(0.25)) <= tolerance);
+  CHECK(std::abs(state.theta[0][1] - uut_type::make_reward(0.75)) <= tolerance);
+  CHECK(std::abs(uut.value(state, 0) - uut_type::make_reward(-0.5)) <= tolerance);
+}
+
+TEST_CASE("A LinUCB bandit does not count a duplicated feature twice") {
+  using uut_type = LinUCBBandit<1, 2>;
+  uut_type uut{};
+  uut_type::state_type state{};
+  uut.set_context({{1, 1}});
+
+  for (int n = 0; n < 1000; ++n)
+    uut.update(state, 0, uut_type::make_reward(0.5));
+
+  CHECK(std::abs(uut.value(state, 0) - uut_type::make_reward(0.5)) <= uut_type::make_reward(0.01));
+}
+
+TEST_CASE("A LinUCB bandit explores a context that an arm has not been seen in") {
+  using uut_type = LinUCBBandit<2, 2>;
+  uut_type uut{1.0};
+  uut_type::state_type state{};
+
+  // Both arms are as good, but arm 1 has only been seen where the second feature is clear
+  for (int n = 0; n < 200; ++n) {
+    uut.set_context({{1, 1}});
+    uut.update(state, 0, uut_type::make_reward(0.3));
+    uut.set_context({{1, -1}});
+    uut.update(state, 1, uut_type::make_reward(0.3));
+  }
+
+  uut.set_context({{1, 1}});
+  CHECK(uut.select_arm(state) == 1);
+  uut.set_context({{1, -1}});
+  CHECK(uut.select_arm(state) == 0);
+}
+
+TEST_CASE("A LinUCB bandit bucket holds a triangular inverse and a weight vector per arm") {
+  STATIC_REQUIRE(sizeof(meta_predictor_linucb_bandit::state_type) == LINUCB_ARMS * (4 * meta_predictor_linucb_bandit::TRIANGLE_SIZE + 2 * LINUCB_DIMENSIONS));
+  STATIC_REQUIRE(champsim::modules::branch_predictor::has_storage_bits<meta_predictor_linucb>);
+
+  meta_predictor_linucb uut{nullptr};
+  REQUIRE(uut.bandits().storage_bits() < 4 * 1024 * 1024);
+}
+
+TEST_CASE("A LinUCB bandit chooses a different arm in each context where a different arm is best") {
+  using uut_type = LinUCBBandit<2, 2>;
+  uut_type uut{0.1};
+  uut_type::state_type state{};
+
+  // Arm 0 is right when the second feature is set, and arm 1 when it is not
+  const std::array<uut_type::context_type, 2> contexts{{{{1, 1}}, {{1, -1}}}};
+  for (int n = 0; n < 2000; ++n) {
+    const auto which = static_cast<std::size_t>(n % 2);
+    uut.set_context(contexts[which]);
+    auto arm = uut.select_arm(state);
+    uut.update(state, arm, uut_type::make_reward((static_cast<std::size_t>(arm) == which) ? 1.0 : -0.5));
+  }
+
+  uut.set_context(contexts[0]);
+  CHECK(uut.select_arm(state) == 0);
+  uut.set_context(contexts[1]);
+  CHECK(uut.select_arm(state) == 1);
+}
+
+TEST_CASE("A LinUCB bandit tries an unseen arm before a known bad one") {
+  using uut_type = LinUCBBandit<2, 1>;
+  uut_type uut{1.0};
+  uut_type::state_type state{};
+  uut.set_context({{1}});
+
+  for (int n = 0; n < 10; ++n)
+    uut.update(state, 0, uut_type::make_reward(-0.5));
+  REQUIRE(uut.select_arm(state) == 1);
+}
@@ -0,0 +1,67 @@
+#include <catch.hpp>
+
+#include "../../../branch/meta_predictor/multiplicative_weights.h"
+
+TEST_CASE("A Hedge vote follows the arms that have been right") {
+  HedgeVote<3> uut{};
+  HedgeVote<3>::state_type state{};
+  const std::array<bool, 3> predictions{{true, false, false}};
+
+  // Two arms outvote one while the weights are equal
+  REQUIRE_FALSE(uut.vote(state, predictions));
+
+  for (int i = 0; i < 10; ++i)
+    uut.update_votes(state, predictions, true);
+  REQUIRE(uut.vote(state, predictions));
+}
+
+TEST_CASE("Hedge log weights stay between the floor and zero") {
+  using namespace multiplicative_weights_detail;
+  HedgeVote<2> uut{};
+  HedgeVote<2>::state_type state{};
+
+  for (int i = 0; i < 1000; ++i)
+    uut.update_votes(state, {{true, false}}, false);
+  CHECK(state.log_weights[0] == LOG_FLOOR);
+  CHECK(state.log_weights[1] == 0);
+
+  for (int i = 0; i < 1000; ++i)
+    uut.update_votes(state, {{true, false}}, true);
+  CHECK(state.log_weights[0] == 0);
+  CHECK(state.log_weights[1] == LOG_FLOOR);
+}
+
+TEST_CASE("An EXP3 bandit settles on the arm with the best reward") {
+  EXP3Bandit<4> uut{};
+  EXP3Bandit<4>::state_type state{};
+  const auto good = EXP3Bandit<4>::make_reward(1.0);
+  const auto bad = EXP3Bandit<4>::make_reward(-0.5);
+
+  for (int i = 0; i < 5000; ++i) {
+    auto arm = uut.select_arm(state);
+    uut.update(state, arm, arm == 2 ? good : bad);
+  }
+
+  int chose_best = 0;
+  for (int i = 0; i < 1000; ++i) {
+    auto arm = uut.select_arm(state);
+    chose_best += (arm == 2);
+    uut.update(state, arm, arm == 2 ? good : bad);
+  }
+  REQUIRE(chose_best > 900);
+}
+
+TEST_CASE("An EXP3 bandit penalizes an arm in proportion to how far its reward falls short") {
+  EXP3Bandit<2> uut{};
+  const auto penalty_for = [&](double reward) {
+    EXP3Bandit<2>::state_type state{};
+    uut.update(state, 0, EXP3Bandit<2>::make_reward(reward));
+    return -state.log_weights[0];
+  };
+
+  CHECK(penalty_for(1.0) == 0);
+  CHECK(penalty_for(0.75) > 0);
+  CHECK(penalty_for(0.75) < penalty_for(0.5));
+  CHECK(penalty_for(0.5) < penalty_for(0.0));
+  CHECK(penalty_for(0.0) < penalty_for(-0.5));
+}
@@ -0,0 +1,72 @@
+#include <catch.hpp>
+
+#include <filesystem>
+#include <vector>
+
+#include "../../../branch/meta_predictor_ucb/meta_predictor_ucb.h"
+#include "instruction.h"
+#include "msl/snapshot.h"
+#include "msl/xoshiro.h"
+
+namespace
+{
+// Run a stream of branches through the predictor, returning its predictions
+std::vector<bool> run_branches(meta_predictor_ucb& uut, uint64_t seed, int count)
+{
+  champsim::msl::xoshiro256starstar rng{seed};
+  std::vector<bool> predictions;
+  for (int i = 0; i < count; ++i) {
+    auto draw = rng();
+    champsim::address ip{0x400000 + ((draw % 64) << 2)};
+    bool taken = ((draw >> 32) % 8) != 0;
+    predictions.push_back(uut.predict_branch(ip));
+    uut.last_branch_result(ip, champsim::address{}, taken, BRANCH_CONDITIONAL);
+  }
+  return predictions;
+}
+} // namespace
+
+TEST_CASE("A meta predictor restored from a snapshot predicts the same as the original") {
+  auto file_name = (std::filesystem::temp_directory_path() / "champsim-meta-predictor.snap").string();
+
+  meta_predictor_ucb original{nullptr};
+  original.initialize_branch_predictor();
+  run_branches(original, 1, 20000);
+  {
+    champsim::msl::snapshot_writer writer{file_name};
+    original.snapshot_branch_predictor(writer);
+  }
+
+  meta_predictor_ucb restored{nullptr};
+  restored.initialize_branch_predictor();
+  {
+    champsim::msl::snapshot_reader reader{file_name};
+    restored.snapshot_branch_predictor(reader);
+    REQUIRE(reader.done());
+  }
+
+  REQUIRE(run_branches(restored, 2, 5000) == run_branches(original, 2, 5000));
+
+  std::filesystem::remove(file_name);
+}
+
+TEST_CASE("A snapshot from one bimodal predictor restores into another") {
+  auto file_name = (std::filesystem::temp_directory_path() / "champsim-bimodal.snap").string();
+  champsim::address ip{0xdeadbeef};
+
+  bimodal original{nullptr};
+  for (int i = 0; i < 100; ++i)
+    original.last_branch_result(ip, champsim::address{}, true, BRANCH_CONDITIONAL);
+  {
+    champsim::msl::snapshot_writer writer{file_name};
+    original.snapshot_branch_predictor(writer);
+  }
+
+  bimodal restored{nullptr};
+  REQUIRE_FALSE(restored.predict_branch(ip));
+  champsim::msl::snapshot_reader reader{file_name};
+  restored.snapshot_branch_predictor(reader);
+  REQUIRE(restored.predict_branch(ip));
+
+  std::filesystem::remove(file_name);
+}
@@ -0,0 +1,149 @@
+#include <catch.hpp>
+
+#include "../../../branch/meta_predictor/meta_predictor_telemetry.h"
+
+TEST_CASE("Meta predictor telemetry counts selections and the chosen arm's outcomes") {
+  MetaPredictorTelemetry<3> uut{4};
+  uut.record_chosen(0, 0x100, 1, true);
+  uut.record_chosen(0, 0x100, 1, false);
+  uut.record_chosen(1, 0x200, 2, true);
+
+  auto stats = uut.stats();
+  REQUIRE(stats.arm_selections == std::vector<uint64_t>{0, 2, 1});
+  REQUIRE(stats.arm_correct == std::vector<uint64_t>{0, 1, 1});
+  REQUIRE(stats.arm_incorrect == std::vector<uint64_t>{0, 1, 0});
+  REQUIRE(stats.regret_branches == 0);
+}
+
+TEST_CASE("Meta predictor regret is measured against the best arm of each bucket") {
+  MetaPredictorTelemetry<2> uut{4};
+
+  // Bucket 0 always chooses arm 0, which is right once. Arm 1 is right three times.
+  uut.record_all(0, 0x100, 0, true, {{true, true}});
+  uut.record_all(0, 0x100, 0, false, {{false, true}});
+  uut.record_all(0, 0x100, 0, false, {{false, true}});
+
+  // Bucket 1 chooses its best arm, so it has no regret
+  uut.record_all(1, 0x200, 1, true, {{false, true}});
+
+  auto stats = uut.stats();
+  REQUIRE(stats.regret == 2);
+  REQUIRE(stats.regret_branches == 4);
+  REQUIRE(stats.arm_correct == std::vector<uint64_t>{1, 4});
+  REQUIRE(stats.arm_incorrect == std::vector<uint64_t>{3, 0});
+}
+
+TEST_CASE("Meta predictor regret is kept when a bucket's slot is reallocated") {
+  MetaPredictorTelemetry<2> uut{1};
+  uut.record_all(0, 0x100, 0, false, {{false, true}});
+  uut.record_all(0, 0x200, 1, true, {{false, true}});
+
+  auto stats = uut.stats();
+  REQUIRE(stats.regret == 1);
+  REQUIRE(stats.regret_branches == 2);
+}
+
+TEST_CASE("A voting meta predictor counts every arm that agreed with the vote as selected") {
+  MetaPredictorTelemetry<3> uut{1};
+  uut.record_all(0, 0x100, -1, true, {{true, false, true}});
+
+  auto stats = uut.stats();
+  REQUIRE(stats.arm_selections == std::vector<uint64_t>{1, 0, 1});
+  REQUIRE(stats.unconverged == 0);
+}
+
+TEST_CASE("A bucket converges once it keeps choosing the same arm") {
+  using uut_type = MetaPredictorTelemetry<2>;
+  uut_type uut{2};
+
+  // Bucket 0 alternates for 10 branches, then settles on arm 1
+  for (int i = 0; i < 10; ++i)
+    uut.record_chosen(0, 0x100, i % 2, true);
+  for (uint32_t i = 0; i < uut_type::CONVERGENCE_RUN - 1; ++i)
+    uut.record_chosen(0, 0x100, 1, true);
+
+  // Bucket 1 never settles
+  for (int i = 0; i < 200; ++i)
+    uut.record_chosen(1, 0x200, i % 2, true);
+
+  auto stats = uut.stats();
+  REQUIRE(stats.unconverged == 1);
+
+  // The run began with the last alternating branch, after 9 branches, which lands in [8, 16)
+  std::array<uint64_t, meta_predictor_stats::CONVERGENCE_BINS> expected{};
+  expected.at(4) = 1;
+  REQUIRE(stats.convergence_times == expected);
+}
+
+TEST_CASE("Meta predictor telemetry measures the chooser against the oracle and the best fixed arm per bucket") {
+  MetaPredictorTelemetry<2> uut{1};
+
+  // Address 0x100 favors arm 0, and 0x200 favors arm 1, after it takes the slot
+  uut.record_all(0, 0x100, 1, false, {{true, false}});
+  uut.record_oracle(0, 0x100, false, {{true, false}});
+  uut.record_all(0, 0x100, 0, true, {{true, true}});
+  uut.record_oracle(0, 0x100, true, {{true, true}});
+  uut.record_all(0, 0x100, 0, false, {{false, false}});
+  uut.record_oracle(0, 0x100, false, {{false, false}});
+  uut.record_all(0, 0x200, 0, false, {{false, true}});
+  uut.record_oracle(0, 0x200, false, {{false, true}});
+
+  auto stats = uut.stats();
+  REQUIRE(stats.oracle_branches == 4);
+  REQUIRE(stats.chooser_correct == 1);
+  REQUIRE(stats.oracle_correct == 3);
+  REQUIRE(stats.static_best_correct == 3);
+}
+
+TEST_CASE("Meta predictor telemetry measures the regret and the best fixed arm over the phase") {
+  MetaPredictorTelemetry<2> uut{1};
+
+  // Arm 0 is best before the phase, and arm 1 within it
+  for (int i = 0; i < 3; ++i) {
+    uut.record_all(0, 0x100, 0, true, {{true, false}});
+    uut.record_oracle(0, 0x100, true, {{true, false}});
+  }
+
+  uut.begin_phase();
+  const auto begin = uut.stats();
+  REQUIRE(begin.regret == 0);
+  REQUIRE(begin.regret_branches == 0);
+  REQUIRE(begin.static_best_correct == 0);
+
+  for (int i = 0; i < 2; ++i) {
+    uut.record_all(0, 0x100, 0, false, {{false, true}});
+    uut.record_oracle(0, 0x100, false, {{false, true}});
+  }
+
+  const auto phase = uut.stats() - begin;
+  REQUIRE(phase.regret == 2);
+  REQUIRE(phase.regret_branches == 2);
+  REQUIRE(phase.oracle_branches == 2);
+  REQUIRE(phase.static_best_correct == 2);
+  REQUIRE(phase.arm_correct == std::vector<uint64_t>{0, 2});
+}
+
+TEST_CASE("Meta predictor telemetry does not measure the oracle unless asked") {
+  MetaPredictorTelemetry<2> uut{1};
+  uut.record_all(0, 0x100, 0, false, {{false, true}});
+
+  auto stats = uut.stats();
+  REQUIRE(stats.oracle_branches == 0);
+  REQUIRE(stats.oracle_correct == 0);
+  REQUIRE(stats.static_best_correct == 0);
+}
+
+TEST_CASE("Meta predictor telemetry counts the arms evaluated and gated in the gated mode") {
+  MetaPredictorTelemetry<3> uut{1};
+  uut.record_gating(3, false, 0, 0);
+  uut.record_gating(3, false, 2, 0);
+  uut.record_gating(1, false, 0, 0);
+  uut.record_gating(3, true, 0, 1);
+
+  auto stats = uut.stats();
+  REQUIRE(stats.gated_branches == 4);
+  REQUIRE(stats.gated_evaluations == 10);
+  REQUIRE(stats.gate_probes == 1);
+  REQUIRE(stats.arms_gated == 2);
+  REQUIRE(stats.arms_reopened == 1);
+}
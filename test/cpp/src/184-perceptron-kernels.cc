@@ -0,0 +1,133 @@
+#include <catch.hpp>
+
+#include <bitset>
+#include <random>
+
+#include "../../../branch/perceptron/perceptron.h"
+#include "msl/fwcounter.h"
+
+namespace
+{
+template <std::size_t HISTLEN>
+perceptron_kernel::history_register<HISTLEN> random_history(std::mt19937_64& rng)
+{
+  perceptron_kernel::history_register<HISTLEN> history;
+  for (std::size_t i = 0; i < HISTLEN; ++i)
+    history.push((rng() & 1) != 0);
+  return history;
+}
+
+// Weights near the bounds, so that training saturates often
+template <std::size_t HISTLEN>
+perceptron_kernel::weight_vector<HISTLEN> random_weights(std::mt19937_64& rng, int8_t lower, int8_t upper)
+{
+  perceptron_kernel::weight_vector<HISTLEN> weights{};
+  std::uniform_int_distribution<int> dist{lower, upper};
+  for (std::size_t i = 0; i < HISTLEN; ++i)
+    weights[i] = static_cast<int8_t>((rng() % 4 == 0) ? ((rng() & 1) ? upper : lower) : dist(rng));
+  return weights;
+}
+
+template <std::size_t HISTLEN>
+void check_kernels_agree(int8_t lower, int8_t upper)
+{
+  std::mt19937_64 rng{HISTLEN};
+  for (int trial = 0; trial < 200; ++trial) {
+    const auto history = random_history<HISTLEN>(rng);
+    const auto taken = (rng() & 1) != 0;
+    const auto weights = random_weights<HISTLEN>(rng, lower, upper);
+
+    auto expected_weights = weights;
+    const auto expected = perceptron_kernel::scalar::output(std::data(weights), history.data(), HISTLEN);
+    perceptron_kernel::scalar::train(std::data(expected_weights), history.data(), HISTLEN, taken, lower, upper);
+
+    auto trained_weights = weights;
+    REQUIRE(perceptron_kernel::output(std::data(weights), history.data(), HISTLEN) == expected);
+    perceptron_kernel::train(std::data(trained_weights), history.data(), HISTLEN, taken, lower, upper);
+    REQUIRE(trained_weights == expected_weights);
+
+#ifdef PERCEPTRON_KERNEL_X86
+    auto sse2_weights = weights;
+    REQUIRE(perceptron_kernel::sse2::output(std::data(weights), history.data(), HISTLEN) == expected);
+    perceptron_kernel::sse2::train(std::data(sse2_weights), history.data(), HISTLEN, taken, lower, upper);
+    REQUIRE(sse2_weights == expected_weights);
+
+    if (perceptron_kernel::avx2::supported) {
+      auto avx2_weights = weights;
+      REQUIRE(perceptron_kernel::avx2::output(std::data(weights), history.data(), HISTLEN) == expected);
+      perceptron_kernel::avx2::train(std::data(avx2_weights), history.data(), HISTLEN, taken, lower, upper);
+      REQUIRE(avx2_weights == expected_weights);
+    }
+#endif
+  }
+}
+} // namespace
+
+TEST_CASE("The packed history register shifts in the most recent outcome at bit 0") {
+  perceptron_kernel::history_register<100> uut;
+  std::bitset<100> reference;
+  std::mt19937_64 rng{1};
+  for (int i = 0; i < 300; ++i) {
+    const auto taken = (rng() & 1) != 0;
+    uut.push(taken);
+    reference <<= 1;
+    reference.set(0, taken);
+  }
+
+  for (std::size_t i = 0; i < 100; ++i)
+    REQUIRE(uut[i] == reference[i]);
+  REQUIRE((uut.data()[1] >> 36) == 0);
+}
+
+TEST_CASE("The packed history register reads a speculative history longer than a word") {
+  champsim::msl::speculative_history<512, 0> history;
+  std::bitset<256> reference;
+  std::mt19937_64 rng{3};
+  for (int i = 0; i < 600; ++i) {
+    const auto taken = (rng() & 1) != 0;
+    auto checkpoint = history.speculate(!taken);
+    history.repair(checkpoint, taken);
+    reference <<= 1;
+    reference.set(0, taken);
+  }
+
+  const auto uut = perceptron_kernel::history_register<256>::recent(history);
+  for (std::size_t i = 0; i < 256; ++i)
+    REQUIRE(uut[i] == reference[i]);
+}
+
+TEST_CASE("The vector perceptron kernels match the scalar kernels") {
+  check_kernels_agree<24>(INT8_MIN, INT8_MAX);
+  check_kernels_agree<64>(INT8_MIN, INT8_MAX);
+  check_kernels_agree<100>(-32, 31);
+  check_kernels_agree<256>(INT8_MIN, INT8_MAX);
+  check_kernels_agree<256>(-8, 7);
+}
+
+TEST_CASE("A perceptron saturates its weights as sfwcounters would") {
+  perceptron::internal_perceptron<24, 8> uut;
+  std::array<champsim::msl::sfwcounter<8>, 24> reference_weights{};
+  champsim::msl::sfwcounter<8> reference_bias{0};
+
+  std::mt19937_64 rng{2};
+  perceptron_kernel::history_register<24> history;
+  std::bitset<24> reference_history;
+  for (int i = 0; i < 2000; ++i) {
+    // Mostly taken, with an always-taken history, so that the weights saturate
+    const auto taken = (i % 500) != 0 && (rng() % 8 != 0);
+    const bool bit = (i % 3 != 0) && (rng() % 8 != 0);
+    history.push(bit);
+    reference_history <<= 1;
+    reference_history.set(0, bit);
+
+    auto expected = reference_bias.value();
+    for (std::size_t j = 0; j < 24; ++j)
+      expected += reference_history[j] ? reference_weights[j].value() : -reference_weights[j].value();
+    REQUIRE(uut.predict(history) == expected);
+
+    uut.update(taken, history);
+    reference_bias += taken ? 1 : -1;
+    for (std::size_t j = 0; j < 24; ++j)
+      reference_weights[j] += (reference_history[j] == taken) ? 1 : -1;
+  }
+}
@@ -0,0 +1,34 @@
+#include <catch.hpp>
+
+#include <array>
+#include <random>
+
+#include "../../../branch/hashed_perceptron/gather_kernel.h"
+
+TEST_CASE("The gathered weight sum matches the scalar sum") {
+  constexpr std::size_t TABLE_SIZE = 1 << 12;
+  constexpr std::size_t NTABLES = 16;
+  std::array<int8_t, NTABLES * TABLE_SIZE + gather_kernel::GATHER_PADDING> weights{};
+
+  std::mt19937_64 rng{3};
+  for (std::size_t i = 0; i < NTABLES * TABLE_SIZE; ++i)
+    weights[i] = static_cast<int8_t>(rng());
+
+  // Include the very last weight, so that the gather reads into the padding
+  std::array<int32_t, NTABLES> offsets{};
+  for (int trial = 0; trial < 1000; ++trial) {
+    for (std::size_t i = 0; i < NTABLES; ++i)
+      offsets[i] = static_cast<int32_t>(i * TABLE_SIZE + ((trial == 0) ? TABLE_SIZE - 1 : rng() % TABLE_SIZE));
+
+    const auto expected = gather_kernel::scalar::sum(std::data(weights), std::data(offsets), NTABLES);
+    REQUIRE(gather_kernel::sum(std::data(weights), std::data(offsets), NTABLES) == expected);
+#ifdef GATHER_KERNEL_X86
+    if (gather_kernel::avx2::supported)
+      REQUIRE(gather_kernel::avx2::sum(std::data(weights), std::data(offsets), NTABLES) == expected);
+#endif
+  }
+
+  // Saturated weights cannot overflow the sum
+  weights.fill(INT8_MIN);
+  REQUIRE(gather_kernel::sum(std::data(weights), std::data(offsets), NTABLES) == 16 * INT8_MIN);
+}
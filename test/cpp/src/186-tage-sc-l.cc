@@ -0,0 +1,115 @@
+#include <catch.hpp>
+
+#include <filesystem>
+#include <vector>
+
+#include "../../../branch/tage_sc_l/tage_sc_l.h"
+#include "instruction.h"
+#include "msl/snapshot.h"
+#include "msl/xoshiro.h"
+
+namespace
+{
+// Predict and resolve one branch, returning whether the prediction was correct
+bool resolve(tage_sc_l& uut, champsim::address ip, bool taken)
+{
+  const bool prediction = uut.predict_branch(ip);
+  uut.last_branch_result(ip, champsim::address{}, taken, BRANCH_CONDITIONAL);
+  return prediction == taken;
+}
+
+std::vector<bool> run_branches(tage_sc_l& uut, uint64_t seed, int count)
+{
+  champsim::msl::xoshiro256starstar rng{seed};
+  std::vector<bool> predictions;
+  for (int i = 0; i < count; ++i) {
+    auto draw = rng();
+    champsim::address ip{0x400000 + ((draw % 64) << 2)};
+    bool taken = ((draw >> 32) % 8) != 0;
+    predictions.push_back(uut.predict_branch(ip));
+    uut.last_branch_result(ip, champsim::address{}, taken, BRANCH_CONDITIONAL);
+  }
+  return predictions;
+}
+} // namespace
+
+TEST_CASE("The TAGE-SC-L predictor learns a biased branch") {
+  tage_sc_l uut{nullptr};
+  champsim::address ip{0xdeadbeef};
+
+  for (int i = 0; i < 100; ++i)
+    resolve(uut, ip, false);
+  REQUIRE_FALSE(uut.predict_branch(ip));
+}
+
+TEST_CASE("The TAGE-SC-L tagged tables do not match entries that were never allocated") {
+  tage_sc_l uut{nullptr};
+
+  // with an empty history, every tag computed for this address is 0, as is the tag of every empty entry
+  REQUIRE_FALSE(uut.predict_branch(champsim::address{0x10000}));
+}
+
+TEST_CASE("The TAGE-SC-L predictor learns a branch correlated with an earlier one") {
+  tage_sc_l uut{nullptr};
+  champsim::address first{0x401000};
+  champsim::address second{0x401040};
+  champsim::msl::xoshiro256starstar rng{1};
+
+  int correct = 0;
+  for (int i = 0; i < 20000; ++i) {
+    const bool outcome = (rng() & 1) != 0;
+    resolve(uut, first, outcome);
+    const bool hit = resolve(uut, second, outcome);
+    if (i >= 19000 && hit)
+      ++correct;
+  }
+  REQUIRE(correct >= 990);
+}
+
+TEST_CASE("The TAGE-SC-L predictor predicts the exit of a loop longer than its history") {
+  tage_sc_l uut{nullptr};
+  champsim::address ip{0x402000};
+  constexpr int TRIP_COUNT = 1000; // longer than the longest history, so only the loop predictor can predict the exit
+
+  int exits_predicted = 0;
+  for (int trip = 0; trip < 30; ++trip) {
+    for (int i = 0; i < TRIP_COUNT; ++i)
+      resolve(uut, ip, true);
+    const bool hit = resolve(uut, ip, false);
+    if (trip >= 20 && hit)
+      ++exits_predicted;
+  }
+  REQUIRE(exits_predicted == 10);
+}
+
+TEST_CASE("A snapshot from one TAGE-SC-L predictor restores into another") {
+  auto file_name = (std::filesystem::temp_directory_path() / "champsim-tage-sc-l.snap").string();
+
+  tage_sc_l original{nullptr};
+  run_branches(original, 1, 20000);
+  {
+    champsim::msl::snapshot_writer writer{file_name};
+    original.snapshot_branch_predictor(writer);
+  }
+
+  tage_sc_l restored{nullptr};
+  {
+    champsim::msl::snapshot_reader reader{file_name};
+    restored.snapshot_branch_predictor(reader);
+    REQUIRE(reader.done());
+  }
+
+  REQUIRE(run_branches(restored, 2, 5000) == run_branches(original, 2, 5000));
+
+  std::filesystem::remove(file_name);
+}
+
+TEST_CASE("The TAGE-SC-L storage is the sum of its tables") {
+  constexpr std::size_t bimodal = 8192 * 2;
+  constexpr std::size_t tagged = 1024 * ((7 + 7 + 8 + 8 + 9 + 10 + 11 + 12 + 12 + 13 + 14 + 15) + 12 * (1 + 3 + 2));
+  constexpr std::size_t loop = 64 * (14 + 14 + 14 + 2 + 3 + 1 + 1);
+  constexpr std::size_t corrector = 5 * 1024 * 6;
+  constexpr std::size_t histories = 640 + 16;
+  constexpr std::size_t adaptive = 4 + 7 + 8 + 6 + 18;
+  REQUIRE(tage_sc_l::storage_bits() == bimodal + tagged + loop + corrector + histories + adaptive);
+}
@@ -0,0 +1,58 @@
+#include <catch.hpp>
+
+#include "../../../branch/meta_predictor_budget/meta_predictor_budget.h"
+#include "../../../branch/meta_predictor_ucb/meta_predictor_ucb.h"
+#include "instruction.h"
+
+namespace
+{
+struct no_storage_predictor : champsim::modules::branch_predictor {
+  using branch_predictor::branch_predictor;
+};
+} // namespace
+
+TEST_CASE("Predictors that report their storage are detected") {
+  STATIC_REQUIRE(champsim::modules::branch_predictor::has_storage_bits<bimodal>);
+  STATIC_REQUIRE(champsim::modules::branch_predictor::has_storage_bits<gshare>);
+  STATIC_REQUIRE(champsim::modules::branch_predictor::has_storage_bits<perceptron>);
+  STATIC_REQUIRE(champsim::modules::branch_predictor::has_storage_bits<hashed_perceptron>);
+  STATIC_REQUIRE(champsim::modules::branch_predictor::has_storage_bits<tage_sc_l>);
+  STATIC_REQUIRE(champsim::modules::branch_predictor::has_storage_bits<meta_predictor_ucb>);
+  STATIC_REQUIRE_FALSE(champsim::modules::branch_predictor::has_storage_bits<no_storage_predictor>);
+}
+
+TEST_CASE("Scaling a predictor scales its storage") {
+  STATIC_REQUIRE(bimodal::storage_bits() == 16384 * 2);
+  STATIC_REQUIRE(basic_bimodal<-1>::storage_bits() == bimodal::storage_bits() / 2);
+  STATIC_REQUIRE(basic_gshare<1>::storage_bits() == 32768 * 2 + 15);
+  STATIC_REQUIRE(basic_hashed_perceptron<-2>::storage_bits() < hashed_perceptron::storage_bits());
+  STATIC_REQUIRE(champsim::modules::branch_predictor::scale_size(4, -4) == 1);
+}
+
+TEST_CASE("The storage of a meta predictor is the sum of its arms and its bandit table") {
+  meta_predictor_ucb uut{nullptr};
+  auto arms = perceptron::storage_bits() + bimodal::storage_bits() + gshare::storage_bits() + hashed_perceptron::storage_bits() + tage_sc_l::storage_bits();
+  REQUIRE(uut.bandits().storage_bits() > 0);
+  REQUIRE(uut.storage_bits() == arms + uut.bandits().storage_bits());
+}
+
+TEST_CASE("The budget meta predictor is the largest that fits in its budget") {
+  constexpr auto scale = meta_predictor_budget_size::LOG_SCALE;
+  STATIC_REQUIRE(meta_predictor_budget_size::total_bits<scale> <= META_PREDICTOR_BUDGET_BITS);
+  STATIC_REQUIRE(meta_predictor_budget_size::total_bits<scale + 1> > META_PREDICTOR_BUDGET_BITS);
+
+  meta_predictor_budget uut{nullptr};
+  REQUIRE(uut.storage_bits() == meta_predictor_budget_size::total_bits<scale>);
+}
+
+TEST_CASE("The budget meta predictor learns a biased branch") {
+  meta_predictor_budget uut{nullptr};
+  uut.initialize_branch_predictor();
+  champsim::address ip{0xdeadbeef};
+
+  for (int i = 0; i < 1000; ++i) {
+    uut.predict_branch(ip);
+    uut.last_branch_result(ip, champsim::address{}, false, BRANCH_CONDITIONAL);
+  }
+  REQUIRE_FALSE(uut.predict_branch(ip));
+}
@@ -0,0 +1,105 @@
+#include <catch.hpp>
+
+#include "../../../branch/meta_predictor/arm_gate.h"
+
+namespace
+{
+using gate_type = ArmGateTable<3>;
+
+// Evaluate and record the branches of one bucket, where each arm is always right or always wrong
+gate_type::change_type run_branches(gate_type& uut, int count, const std::array<bool, 3>& arm_correct)
+{
+  gate_type::change_type total;
+  for (int i = 0; i < count; ++i) {
+    auto change = uut.record(0, uut.evaluate(0), arm_correct);
+    total.gated += change.gated;
+    total.reopened += change.reopened;
+  }
+  return total;
+}
+} // namespace
+
+TEST_CASE("An arm gate table evaluates every arm of a new bucket") {
+  gate_type uut{4};
+  REQUIRE(uut.evaluate(2) == gate_type::ALL_ARMS);
+  REQUIRE(uut.active(2) == gate_type::ALL_ARMS);
+}
+
+TEST_CASE("An arm gate table gates the arms whose accuracy is bounded below another arm's") {
+  gate_type uut{1};
+
+  auto change = run_branches(uut, 100, {{false, true, false}});
+
+  REQUIRE(uut.active(0) == 0b010);
+  REQUIRE(uut.leader(0) == 1);
+  REQUIRE(change.gated == 2);
+  REQUIRE(change.reopened == 0);
+}
+
+TEST_CASE("An arm gate table gates an arm only once its bound falls strictly below the leader's") {
+  gate_type uut{1};
+
+  // Arm 0 is right half the time and arm 1 always, so their bounds meet at 0.75 after 48 branches
+  for (int i = 0; i < 48; ++i)
+    uut.record(0, uut.evaluate(0), {{i % 2 == 0, true, true}});
+  REQUIRE(uut.active(0) == gate_type::ALL_ARMS);
+
+  for (int i = 48; i < 64; ++i)
+    uut.record(0, uut.evaluate(0), {{i % 2 == 0, true, true}});
+  REQUIRE(uut.active(0) == 0b110);
+}
+
+TEST_CASE("An arm gate table does not gate arms that are close") {
+  gate_type uut{1};
+
+  for (int i = 0; i < 1000; ++i)
+    uut.record(0, uut.evaluate(0), {{i % 10 != 0, i % 10 != 1, false}});
+
+  REQUIRE(uut.active(0) == 0b011);
+}
+
+TEST_CASE("An arm gate table does not gate an arm it has not evaluated") {
+  gate_type uut{1};
+
+  for (int i = 0; i < 100; ++i)
+    uut.record(0, 0b001, {{false, true, true}});
+
+  REQUIRE(uut.active(0) == gate_type::ALL_ARMS);
+}
+
+TEST_CASE("An arm gate table probes every arm once per probe interval") {
+  gate_type uut{1};
+  run_branches(uut, 100, {{false, true, false}});
+  REQUIRE(uut.active(0) == 0b010);
+
+  int probes = 0;
+  for (int i = 0; i < gate_type::PROBE_INTERVAL; ++i) {
+    const auto evaluated = uut.evaluate(0);
+    probes += (evaluated == gate_type::ALL_ARMS);
+    uut.record(0, evaluated, {{false, true, false}});
+  }
+
+  REQUIRE(probes == 1);
+}
+
+TEST_CASE("An arm gate table reopens a gated arm once the leader falls behind it") {
+  gate_type uut{1};
+  run_branches(uut, 100, {{false, true, false}});
+  REQUIRE(uut.active(0) == 0b010);
+
+  auto change = run_branches(uut, 1000, {{true, false, false}});
+
+  REQUIRE((uut.active(0) & 0b001) != 0);
+  REQUIRE(uut.leader(0) == 0);
+  REQUIRE(change.reopened >= 1);
+}
+
+TEST_CASE("Resetting an arm gate table bucket makes every arm active again") {
+  gate_type uut{2};
+  run_branches(uut, 100, {{false, true, false}});
+
+  uut.reset(0);
+
+  REQUIRE(uut.active(0) == gate_type::ALL_ARMS);
+  REQUIRE(uut.evaluate(0) == gate_type::ALL_ARMS);
+}
@@ -0,0 +1,54 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include "../../../branch/gshare/gshare.h"
+#include "../../../branch/hashed_perceptron/hashed_perceptron.h"
+#include "../../../branch/perceptron/perceptron.h"
+#include "../../../branch/tage_sc_l/tage_sc_l.h"
+#include "instruction.h"
+#include "msl/xoshiro.h"
+
+namespace
+{
+using prediction_id = champsim::modules::branch_predictor::prediction_id;
+
+// Predict and resolve a stream of branches with consecutive identifiers, returning the predictions
+template <typename Predictor>
+std::vector<bool> run_branches(Predictor& uut, prediction_id& next_id, uint64_t seed, int count)
+{
+  champsim::msl::xoshiro256starstar rng{seed};
+  std::vector<bool> predictions;
+  for (int i = 0; i < count; ++i) {
+    auto draw = rng();
+    champsim::address ip{0x400000 + ((draw % 64) << 2)};
+    bool taken = ((draw >> 32) % 8) != 0;
+    const auto id = next_id++;
+    predictions.push_back(uut.predict_branch(id, ip, champsim::address{}, false, BRANCH_CONDITIONAL));
+    uut.last_branch_result(id, ip, champsim::address{}, taken, BRANCH_CONDITIONAL);
+  }
+  return predictions;
+}
+} // namespace
+
+TEMPLATE_TEST_CASE("A branch resolved after its prediction was lost changes nothing", "", gshare, hashed_perceptron, perceptron, tage_sc_l) {
+  TestType lost{nullptr};
+  TestType control{nullptr};
+  if constexpr (champsim::modules::branch_predictor::has_initialize<TestType&>) {
+    lost.initialize_branch_predictor();
+    control.initialize_branch_predictor();
+  }
+
+  // The first branch is predicted, then overwritten by later predictions before it is resolved
+  const champsim::address ip{0x400100};
+  prediction_id lost_next = 0;
+  prediction_id control_next = 0;
+  lost.predict_branch(lost_next++, ip, champsim::address{}, false, BRANCH_CONDITIONAL);
+  control.predict_branch(control_next++, ip, champsim::address{}, false, BRANCH_CONDITIONAL);
+  run_branches(lost, lost_next, 1, 2 * champsim::modules::branch_predictor::MAX_PREDICTIONS_IN_FLIGHT);
+  run_branches(control, control_next, 1, 2 * champsim::modules::branch_predictor::MAX_PREDICTIONS_IN_FLIGHT);
+
+  lost.last_branch_result(0, ip, champsim::address{}, true, BRANCH_CONDITIONAL);
+
+  REQUIRE(run_branches(lost, lost_next, 2, 5000) == run_branches(control, control_next, 2, 5000));
+}
@@ -108,3 +108,66 @@ TEST_CASE("The ROB occupancy modifies the flush penalty") {
 
   REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
 }
+
+TEST_CASE("Meta predictor telemetry is printed after the branch type MPKI") {
+  cpu_stats given{};
+  given.name = "test_cpu";
+  given.meta_predictor.arm_selections = {30, 10};
+  given.meta_predictor.arm_correct = {24, 5};
+  given.meta_predictor.arm_incorrect = {6, 5};
+  given.meta_predictor.regret = 3;
+  given.meta_predictor.regret_branches = 40;
+  given.meta_predictor.convergence_times.at(0) = 1;
+  given.meta_predictor.convergence_times.at(3) = 2;
+  given.meta_predictor.unconverged = 4;
+
+  std::vector<std::string> expected{
+    "test_cpu Meta predictor regret: 3 over 40 branches",
+    "test_cpu Meta predictor arm 0 selected: 30 correct: 24 incorrect: 6 accuracy: 80%",
+    "test_cpu Meta predictor arm 1 selected: 10 correct: 5 incorrect: 5 accuracy: 50%",
+    "test_cpu Meta predictor convergence time: 0: 1 1: 0 2: 0 4: 2 8: 0 16: 0 32: 0 64: 0 128: 0 256: 0 512: 0 1024: 0 2048: 0 4096: 0 8192: 0 16384: 0 unconverged: 4"
+  };
+
+  auto lines = champsim::plain_printer::format(given);
+  REQUIRE(std::size(lines) == 9 + std::size(expected));
+  REQUIRE_THAT(std::vector<std::string>(std::next(std::begin(lines), 9), std::end(lines)), Catch::Matchers::RangeEquals(expected));
+}
+
+TEST_CASE("The oracle accuracies of a meta predictor are printed next to its chooser's") {
+  cpu_stats given{};
+  given.name = "test_cpu";
+  given.meta_predictor.arm_selections = {30, 10};
+  given.meta_predictor.arm_correct = {24, 5};
+  given.meta_predictor.arm_incorrect = {16, 35};
+  given.meta_predictor.regret = 3;
+  given.meta_predictor.regret_branches = 40;
+  given.meta_predictor.oracle_branches = 40;
+  given.meta_predictor.chooser_correct = 20;
+  given.meta_predictor.oracle_correct = 30;
+  given.meta_predictor.static_best_correct = 24;
+
+  auto lines = champsim::plain_printer::format(given);
+  REQUIRE(std::size(lines) >= 11);
+  CHECK(lines.at(9) == "test_cpu Meta predictor regret: 3 over 40 branches");
+  CHECK(lines.at(10) == "test_cpu Meta predictor chooser accuracy: 50% oracle accuracy: 75% static best arm accuracy: 60% over 40 branches");
+}
+
+TEST_CASE("The gating of a meta predictor's arms is printed after its regret") {
+  cpu_stats given{};
+  given.name = "test_cpu";
+  given.meta_predictor.arm_selections = {30, 10};
+  given.meta_predictor.arm_correct = {24, 5};
+  given.meta_predictor.arm_incorrect = {6, 5};
+  given.meta_predictor.regret = 3;
+  given.meta_predictor.regret_branches = 4;
+  given.meta_predictor.gated_branches = 40;
+  given.meta_predictor.gated_evaluations = 60;
+  given.meta_predictor.gate_probes = 2;
+  given.meta_predictor.arms_gated = 3;
+  given.meta_predictor.arms_reopened = 1;
+
+  auto lines = champsim::plain_printer::format(given);
+  REQUIRE(std::size(lines) >= 11);
+  CHECK(lines.at(9) == "test_cpu Meta predictor regret: 3 over 4 branches");
+  CHECK(lines.at(10) == "test_cpu Meta predictor gating: 1.5 of 2 arms evaluated per branch over 40 branches probes: 2 arms gated: 3 reopened: 1");
+}
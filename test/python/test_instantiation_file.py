@@ -74,6 +74,9 @@ class CpuBuilderTest(unittest.TestCase):
     def test_mispredict_penalty(self):
         self.get_element_diff(['.mispredict_penalty(1)'], mispredict_penalty=1)
 
+    def test_branch_resolution(self):
+        self.get_element_diff(['.branch_resolution(champsim::branch_resolution_stage::retire)'], branch_resolution='retire')
+
     def test_decode_latency(self):
         self.get_element_diff(['.decode_latency(1)'], decode_latency=1)
 
@@ -0,0 +1,21 @@
+import unittest
+
+import config.makefile
+
+class BpsimExecutableTests(unittest.TestCase):
+
+    def test_default_name(self):
+        self.assertEqual(config.makefile.bpsim_executable('champsim'), 'bpsim')
+
+    def test_generated_name(self):
+        self.assertEqual(config.makefile.bpsim_executable('champsim_a_b'), 'bpsim_a_b')
+
+    def test_custom_name(self):
+        self.assertEqual(config.makefile.bpsim_executable('b_exec'), 'b_exec_bpsim')
+
+class MakefileLinesTests(unittest.TestCase):
+
+    def test_bpsim_shares_build_id(self):
+        lines = '\n'.join(config.makefile.get_makefile_lines('0123456789abcdef', 'bin/champsim', {}))
+        self.assertIn('$(BIN_ROOT)/champsim $(BIN_ROOT)/bpsim: build_id :=', lines)
+        self.assertIn('bpsim_name += $(BIN_ROOT)/bpsim', lines)
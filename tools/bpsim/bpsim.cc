@@ -0,0 +1,334 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * A replay driver for the branch predictors.
+ *
+ * The trace is read with the same tracereader as the simulator, and each instruction is predicted and trained by the branch predictor and BTB of
+ * each configured core, in trace order. No other part of the core or the memory hierarchy is simulated, so there are no cycles, and every branch is
+ * resolved before the next is predicted, unless a resolution delay is given. The statistics are printed in the same formats as the simulator's.
+ *
+ * The cores are independent, so a configuration with several cores evaluates several predictors over the same trace at once. The trace is
+ * decoded only once, on the main thread, into batches of branch records in a ring. Each core runs on its own thread and reads every batch.
+ *
+ * A branch trace written by bptrace_extract can be replayed in place of the full trace. It holds only the branches, so the
+ * predictors are not called for the other instructions, but they are still counted toward the warmup and simulation lengths.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <string>
+#include <vector>
+#include <CLI/CLI.hpp>
+#include <fmt/core.h>
+
+#include "batch_ring.h"
+#include "branch_trace.h"
+#include "champsim.h"
+#include "core_inst.inc"
+#include "environment.h"
+#include "ooo_cpu.h"
+#include "phase_info.h"
+#include "stats_printer.h"
+#include "tracereader.h"
+
+namespace champsim
+{
+void save_branch_state(environment& env, const std::string& file_name);
+void load_branch_state(environment& env, const std::string& file_name);
+} // namespace champsim
+
+using configured_environment = champsim::configured::generated_environment<CHAMPSIM_BUILD>;
+
+const std::size_t NUM_CPUS = configured_environment::num_cpus;
+
+const unsigned BLOCK_SIZE = configured_environment::block_size;
+const unsigned PAGE_SIZE = configured_environment::page_size;
+const unsigned LOG2_BLOCK_SIZE = champsim::lg2(BLOCK_SIZE);
+const unsigned LOG2_PAGE_SIZE = champsim::lg2(PAGE_SIZE);
+
+namespace
+{
+using batch_type = std::vector<champsim::branch_record>;
+constexpr std::size_t BATCH_RECORDS = 1 << 14;
+constexpr std::size_t RING_BATCHES = 8;
+
+// Each read gives the next record, and the number of trace instructions it accounts for
+struct full_trace {
+  champsim::tracereader reader;
+
+  champsim::branch_record operator()() { return champsim::make_record(reader()); }
+  [[nodiscard]] bool eof() const { return reader.eof(); }
+};
+
+struct branch_trace {
+  champsim::branch_tracereader reader;
+  uint64_t instructions_read = 0;
+
+  champsim::branch_record operator()()
+  {
+    auto record = reader();
+    instructions_read += record.instructions;
+
+    // The last branch also accounts for the instructions that follow it
+    if (reader.eof()) {
+      record.instructions += reader.instructions() - instructions_read;
+    }
+    return record;
+  }
+  [[nodiscard]] bool eof() const { return reader.eof(); }
+};
+
+/**
+ * Decode the trace into batches, until it ends or the given number of instructions have been read.
+ */
+template <typename Trace>
+void read_batches(Trace&& trace, champsim::batch_ring<batch_type>& ring, long long length)
+{
+  long long instr_count = 0;
+  while (instr_count < length && !trace.eof()) {
+    batch_type batch;
+    batch.reserve(BATCH_RECORDS);
+    while (std::size(batch) < BATCH_RECORDS && instr_count < length && !trace.eof()) {
+      batch.push_back(trace());
+      instr_count += static_cast<long long>(batch.back().instructions);
+    }
+    ring.push(std::move(batch));
+  }
+}
+
+/**
+ * One core's position in the ring of batches.
+ */
+class batch_cursor
+{
+  champsim::batch_ring<batch_type>& ring;
+  std::size_t consumer;
+  std::shared_ptr<const batch_type> batch;
+  std::size_t position = 0;
+
+public:
+  batch_cursor(champsim::batch_ring<batch_type>& batches, std::size_t index) : ring(batches), consumer(index) {}
+  batch_cursor(const batch_cursor&) = delete;
+  batch_cursor& operator=(const batch_cursor&) = delete;
+  ~batch_cursor() { ring.leave(consumer); }
+
+  bool eof()
+  {
+    if (batch == nullptr || position == std::size(*batch)) {
+      batch = ring.pop(consumer);
+      position = 0;
+    }
+    return batch == nullptr;
+  }
+
+  const champsim::branch_record& operator()() { return (*batch)[position++]; }
+};
+
+// The predictors keep the state of a prediction only until this many more have been made, one for each instruction
+constexpr std::size_t MAX_PREDICTIONS_IN_FLIGHT = champsim::modules::branch_predictor::MAX_PREDICTIONS_IN_FLIGHT;
+
+/**
+ * Predict and train on up to the given number of instructions, returning the statistics for them.
+ *
+ * Each branch is resolved once resolution_delay more branches have been predicted after it, or earlier if its prediction would otherwise be
+ * overwritten, since then it could not be trained. Those resolved early are counted in early_resolutions. Branches still in flight at the end are
+ * left in in_flight for the next phase.
+ */
+cpu_stats replay(O3_CPU& cpu, batch_cursor& trace, long long length, long long& instr_count, std::deque<ooo_model_instr>& in_flight,
+                 std::size_t resolution_delay, uint64_t& early_resolutions)
+{
+  cpu_stats stats{};
+  stats.name = "CPU " + std::to_string(cpu.cpu);
+  stats.begin_instrs = instr_count;
+  stats.branch_predictor_storage_bits = cpu.impl_branch_predictor_storage_bits();
+  cpu.impl_begin_phase_branch_predictor();
+  const auto begin_meta_predictor = cpu.impl_meta_predictor_telemetry();
+
+  while (instr_count - stats.begin_instrs < length && !trace.eof()) {
+    const auto& record = trace();
+    instr_count += static_cast<long long>(record.instructions);
+    auto arch_instr = champsim::make_instr(static_cast<uint8_t>(cpu.cpu), record);
+
+    // As in the core, every instruction is predicted, since it is not known to be a branch until it is decoded
+    stats.total_branch_types.increment(arch_instr.branch);
+    auto [predicted_branch_target, always_taken] = cpu.impl_btb_prediction(arch_instr.ip, arch_instr.branch);
+    arch_instr.branch_prediction_id = cpu.next_branch_prediction_id++;
+    arch_instr.branch_prediction =
+        cpu.impl_predict_branch(arch_instr.branch_prediction_id, arch_instr.ip, predicted_branch_target, always_taken, arch_instr.branch) || always_taken;
+    if (!arch_instr.branch_prediction) {
+      predicted_branch_target = champsim::address{};
+    }
+
+    if (arch_instr.is_branch) {
+      if (O3_CPU::is_mispredicted(arch_instr, predicted_branch_target)) {
+        stats.branch_type_misses.increment(arch_instr.branch);
+
+        // Only the correct path is replayed, so the speculative history is repaired before the next branch is predicted
+        cpu.impl_repair_branch_history(arch_instr.branch_prediction_id, arch_instr.ip, arch_instr.branch_target, arch_instr.branch_taken,
+                                       arch_instr.branch);
+      }
+
+      cpu.impl_update_btb(arch_instr.ip, arch_instr.branch_target, arch_instr.branch_taken, arch_instr.branch);
+      in_flight.push_back(std::move(arch_instr));
+    }
+
+    while (!std::empty(in_flight)
+           && (std::size(in_flight) > resolution_delay || cpu.next_branch_prediction_id - in_flight.front().branch_prediction_id >= MAX_PREDICTIONS_IN_FLIGHT)) {
+      const auto& branch = in_flight.front();
+      if (std::size(in_flight) <= resolution_delay) {
+        ++early_resolutions;
+      }
+      cpu.impl_last_branch_result(branch.branch_prediction_id, branch.ip, branch.branch_target, branch.branch_taken, branch.branch);
+      in_flight.pop_front();
+    }
+  }
+
+  stats.end_instrs = instr_count;
+  stats.meta_predictor = cpu.impl_meta_predictor_telemetry() - begin_meta_predictor;
+  return stats;
+}
+
+/**
+ * Replay the warmup and simulation phases for one core, returning the statistics for the simulation phase.
+ */
+cpu_stats replay_phases(O3_CPU& cpu, champsim::batch_ring<batch_type>& ring, std::size_t consumer, long long warmup_instructions,
+                        long long simulation_instructions, std::size_t resolution_delay, uint64_t& early_resolutions)
+{
+  batch_cursor trace{ring, consumer};
+  long long instr_count = 0;
+  std::deque<ooo_model_instr> in_flight;
+  replay(cpu, trace, warmup_instructions, instr_count, in_flight, resolution_delay, early_resolutions);
+  return replay(cpu, trace, simulation_instructions, instr_count, in_flight, resolution_delay, early_resolutions);
+}
+} // namespace
+
+int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
+{
+  configured_environment gen_environment{};
+
+  CLI::App app{"A replay driver for ChampSim branch predictors"};
+
+  bool knob_cloudsuite{false};
+  long long warmup_instructions = 0;
+  long long simulation_instructions = std::numeric_limits<long long>::max();
+  std::size_t resolution_delay = 0;
+  std::string json_file_name;
+  std::string load_branch_file_name;
+  std::string save_branch_file_name;
+  std::string trace_name;
+
+  app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Read the trace using the cloudsuite format");
+  auto* warmup_instr_option = app.add_option("-w,--warmup-instructions", warmup_instructions, "The number of instructions in the warmup phase");
+  auto* sim_instr_option = app.add_option("-i,--simulation-instructions", simulation_instructions,
+                                          "The number of instructions in the detailed phase. If not specified, run to the end of the trace.");
+  auto* json_option =
+      app.add_option("--json", json_file_name, "The name of the file to receive JSON output. If no name is specified, stdout will be used")->expected(0, 1);
+  app.add_option("--resolution-delay", resolution_delay,
+                 "Resolve each branch only after this many more branches have been predicted, as if it were resolved late in the pipeline")
+      ->check(CLI::Range(std::size_t{0}, MAX_PREDICTIONS_IN_FLIGHT - 1));
+  app.add_option("--load-branch-state", load_branch_file_name, "Restore the branch predictors from this snapshot before the warmup phase")
+      ->check(CLI::ExistingFile);
+  app.add_option("--save-branch-state", save_branch_file_name, "Save a snapshot of the branch predictors to this file at the end of the replay");
+  app.add_option("trace", trace_name, "The path to the trace")->required()->check(CLI::ExistingFile);
+
+  CLI11_PARSE(app, argc, argv);
+
+  const bool warmup_given = (warmup_instr_option->count() > 0);
+  const bool simulation_given = (sim_instr_option->count() > 0);
+  if (simulation_given && !warmup_given) {
+    // Warmup is 20% by default
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    warmup_instructions = simulation_instructions / 5;
+  }
+  const long long total_instructions = (simulation_instructions > std::numeric_limits<long long>::max() - warmup_instructions)
+                                           ? std::numeric_limits<long long>::max()
+                                           : warmup_instructions + simulation_instructions;
+
+  auto cpus = gen_environment.cpu_view();
+  for (O3_CPU& cpu : cpus) {
+    cpu.impl_initialize_branch_predictor();
+    cpu.impl_initialize_btb();
+  }
+  if (!load_branch_file_name.empty()) {
+    champsim::load_branch_state(gen_environment, load_branch_file_name);
+  }
+
+  fmt::print("\n*** ChampSim Branch Predictor Replay ***\nWarmup Instructions: {}\nSimulation Instructions: {}\nNumber of CPUs: {}\n\n", warmup_instructions,
+             simulation_instructions, std::size(cpus));
+
+  const auto start_time = std::chrono::steady_clock::now();
+  champsim::batch_ring<batch_type> ring{RING_BATCHES, std::size(cpus)};
+  std::vector<std::future<cpu_stats>> workers;
+  std::vector<uint64_t> early_resolutions(std::size(cpus), 0);
+  for (std::size_t i = 0; i < std::size(cpus); ++i) {
+    workers.push_back(std::async(std::launch::async, replay_phases, std::ref(cpus.at(i).get()), std::ref(ring), i, warmup_instructions,
+                                 simulation_instructions, resolution_delay, std::ref(early_resolutions.at(i))));
+  }
+
+  // Branch traces are not repeated, since they are not read through the simulator's tracereader
+  try {
+    if (champsim::branch_tracereader::is_branch_trace(trace_name)) {
+      read_batches(branch_trace{champsim::branch_tracereader{trace_name}}, ring, total_instructions);
+    } else {
+      read_batches(full_trace{get_tracereader(trace_name, 0, knob_cloudsuite, simulation_given)}, ring, total_instructions);
+    }
+  } catch (...) {
+    ring.close();
+    throw;
+  }
+  ring.close();
+
+  std::vector<cpu_stats> stats;
+  for (auto& worker : workers) {
+    stats.push_back(worker.get());
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+  fmt::print("Replayed {} instructions in {:.3g} seconds\n", stats.front().end_instrs, elapsed.count());
+  for (std::size_t i = 0; i < std::size(cpus); ++i) {
+    if (early_resolutions.at(i) > 0) {
+      fmt::print("CPU {} resolved {} branches before the resolution delay, since their predictions would have been lost\n", i, early_resolutions.at(i));
+    }
+  }
+  fmt::print("\n");
+
+  std::vector<champsim::phase_stats> phase_stats{
+      champsim::phase_stats{"Simulation", std::vector<std::string>(std::size(cpus), trace_name), stats, stats, {}, {}, {}, {}}};
+  champsim::plain_printer{std::cout}.print(phase_stats);
+
+  for (O3_CPU& cpu : cpus) {
+    cpu.impl_branch_predictor_final_stats();
+  }
+
+  if (json_option->count() > 0) {
+    if (json_file_name.empty()) {
+      champsim::json_printer{std::cout}.print(phase_stats);
+    } else {
+      std::ofstream json_file{json_file_name};
+      champsim::json_printer{json_file}.print(phase_stats);
+    }
+  }
+
+  if (!save_branch_file_name.empty()) {
+    champsim::save_branch_state(gen_environment, save_branch_file_name);
+  }
+
+  return 0;
+}
@@ -0,0 +1,221 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * A sweep over the parameters of meta_predictor.
+ *
+ * The candidates are taken from a grid or drawn at random from the search space, and searched with successive halving over a list of
+ * branch traces. Each candidate is its own meta_predictor, built directly with its parameters rather than through a configuration, so
+ * nothing is rebuilt between candidates. As in bpsim, each trace is decoded once per round, into a ring of batches that is read by
+ * every worker thread. Each worker drives its share of the candidates over each batch.
+ *
+ * Only the direction of conditional branches is scored, since there is no BTB. The MPKI of a round is over the whole prefix,
+ * including the start, where the predictors are cold.
+ */
+
+#include <algorithm>
+#include <future>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <CLI/CLI.hpp>
+#include <fmt/core.h>
+
+#include "../../branch/meta_predictor/meta_predictor.h"
+#include "batch_ring.h"
+#include "branch_trace.h"
+#include "parameter_sweep.h"
+
+namespace
+{
+using batch_type = std::vector<champsim::branch_record>;
+constexpr std::size_t BATCH_RECORDS = 1 << 14;
+constexpr std::size_t RING_BATCHES = 8;
+constexpr std::size_t MAX_BANDIT_SET_BITS = 20;
+
+// The parameters, in the order of the search space
+meta_predictor_parameters make_parameters(const champsim::sweep::candidate& candidate)
+{
+  return meta_predictor_parameters{candidate.at(0), candidate.at(1), candidate.at(2), candidate.at(3), static_cast<std::size_t>(candidate.at(4))};
+}
+
+/**
+ * Decode up to the given number of instructions of the trace into the ring, returning the number decoded.
+ */
+long long read_prefix(const std::string& trace_name, champsim::batch_ring<batch_type>& ring, long long length)
+{
+  champsim::branch_tracereader trace{trace_name};
+  long long instr_count = 0;
+  while (instr_count < length && !trace.eof()) {
+    batch_type batch;
+    batch.reserve(BATCH_RECORDS);
+    while (std::size(batch) < BATCH_RECORDS && instr_count < length && !trace.eof()) {
+      batch.push_back(trace());
+      instr_count += static_cast<long long>(batch.back().instructions);
+    }
+    ring.push(std::move(batch));
+  }
+
+  // Count the instructions after the last branch
+  if (trace.eof()) {
+    instr_count = std::min(length, static_cast<long long>(trace.instructions()));
+  }
+  return instr_count;
+}
+
+/**
+ * Drive every candidate whose index is congruent to the worker's over every batch, adding to their misprediction counts.
+ */
+void replay_share(champsim::batch_ring<batch_type>& ring, std::size_t worker, std::size_t num_workers, const std::vector<champsim::sweep::candidate>& candidates,
+                  std::vector<uint64_t>& mispredictions)
+{
+  try {
+    std::vector<std::unique_ptr<meta_predictor>> predictors;
+    for (auto i = worker; i < std::size(candidates); i += num_workers) {
+      predictors.push_back(std::make_unique<meta_predictor>(nullptr, make_parameters(candidates[i])));
+      predictors.back()->initialize_branch_predictor();
+    }
+
+    for (auto batch = ring.pop(worker); batch != nullptr; batch = ring.pop(worker)) {
+      for (std::size_t k = 0; k < std::size(predictors); ++k) {
+        auto& predictor = *predictors[k];
+        auto& misses = mispredictions[worker + k * num_workers];
+        for (const auto& record : *batch) {
+          const bool prediction = predictor.predict_branch(record.ip);
+          if ((record.type == BRANCH_CONDITIONAL || record.type == BRANCH_OTHER) && prediction != record.taken) {
+            ++misses;
+          }
+          predictor.last_branch_result(record.ip, record.target, record.taken, record.type);
+        }
+      }
+    }
+  } catch (...) {
+    ring.leave(worker);
+    throw;
+  }
+}
+
+/**
+ * Evaluate the candidates on a prefix of every trace, returning the MPKI of each over all of the traces.
+ */
+std::vector<double> evaluate(const std::vector<std::string>& trace_names, const std::vector<champsim::sweep::candidate>& candidates, long long length,
+                             std::size_t jobs)
+{
+  fmt::print("Evaluating {} candidates on {} instructions of each trace\n", std::size(candidates), length);
+
+  std::vector<uint64_t> mispredictions(std::size(candidates));
+  long long instructions = 0;
+  for (const auto& trace_name : trace_names) {
+    const auto num_workers = std::clamp<std::size_t>(jobs, 1, std::size(candidates));
+    champsim::batch_ring<batch_type> ring{RING_BATCHES, num_workers};
+
+    std::vector<std::future<void>> workers;
+    for (std::size_t i = 0; i < num_workers; ++i) {
+      workers.push_back(std::async(std::launch::async, replay_share, std::ref(ring), i, num_workers, std::cref(candidates), std::ref(mispredictions)));
+    }
+
+    try {
+      instructions += read_prefix(trace_name, ring, length);
+    } catch (...) {
+      ring.close();
+      throw;
+    }
+    ring.close();
+
+    for (auto& worker : workers) {
+      worker.get();
+    }
+  }
+
+  std::vector<double> mpki;
+  std::transform(std::begin(mispredictions), std::end(mispredictions), std::back_inserter(mpki),
+                 [instructions](auto misses) { return 1000.0 * static_cast<double>(misses) / static_cast<double>(std::max(instructions, 1LL)); });
+  return mpki;
+}
+} // namespace
+
+int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
+{
+  CLI::App app{"A parameter sweep for the ChampSim meta predictor"};
+
+  const meta_predictor_parameters defaults{};
+  std::string epsilon_spec = fmt::format("{}", defaults.initial_epsilon);
+  std::string decay_spec = fmt::format("{}", defaults.decay_rate);
+  std::string reward_correct_spec = fmt::format("{}", defaults.reward_correct);
+  std::string reward_incorrect_spec = fmt::format("{}", defaults.reward_incorrect);
+  std::string bucket_bits_spec = fmt::format("{}", defaults.bandit_set_bits);
+  std::size_t samples = 0;
+  uint64_t seed = 0;
+  champsim::sweep::halving_schedule schedule{};
+  std::size_t jobs = std::max(1u, std::thread::hardware_concurrency());
+  std::vector<std::string> trace_names;
+
+  const std::string spec_help = "A list of values (a,b,c), a range (lower:upper), or a logarithmic range (lower:upper:log)";
+  app.add_option("--epsilon", epsilon_spec, "The initial exploration rate. " + spec_help);
+  app.add_option("--decay", decay_spec, "The decay rate of the exploration rate. " + spec_help);
+  app.add_option("--reward-correct", reward_correct_spec, "The reward for a correct prediction. " + spec_help);
+  app.add_option("--reward-incorrect", reward_incorrect_spec, "The reward for an incorrect prediction. " + spec_help);
+  app.add_option("--bucket-bits", bucket_bits_spec, "The base-2 logarithm of the number of bandit table sets. " + spec_help);
+  auto* samples_option = app.add_option("--samples", samples, "Draw this many candidates at random, instead of searching the grid of every listed value");
+  app.add_option("--seed", seed, "The seed for drawing candidates");
+  app.add_option("--min-instructions", schedule.min_instructions, "The length of the prefix every candidate is evaluated on");
+  auto* max_instr_option = app.add_option("-i,--max-instructions", schedule.max_instructions,
+                                          "The length of the prefix the last candidates are evaluated on. If not specified, the length of the shortest trace.");
+  app.add_option("--reduction", schedule.reduction, "Each round keeps one in this many candidates, and runs them this many times longer");
+  app.add_option("-j,--jobs", jobs, "The number of worker threads");
+  app.add_option("traces", trace_names, "The branch traces, written by bptrace_extract")->required()->check(CLI::ExistingFile);
+
+  CLI11_PARSE(app, argc, argv);
+
+  champsim::sweep::search_space space{
+      champsim::sweep::parameter_space::parse("epsilon", epsilon_spec),
+      champsim::sweep::parameter_space::parse("decay", decay_spec),
+      champsim::sweep::parameter_space::parse("reward_correct", reward_correct_spec),
+      champsim::sweep::parameter_space::parse("reward_incorrect", reward_incorrect_spec),
+      champsim::sweep::parameter_space::parse("bucket_bits", bucket_bits_spec),
+  };
+  space.back().integral = true;
+
+  auto candidates = (samples_option->count() > 0) ? champsim::sweep::sample(space, samples, seed) : champsim::sweep::grid(space);
+  for (const auto& candidate : candidates) {
+    if (candidate.back() < 0 || candidate.back() > MAX_BANDIT_SET_BITS || candidate.back() != std::round(candidate.back())) {
+      throw std::invalid_argument{fmt::format("The bucket bits must be whole numbers from 0 to {}", MAX_BANDIT_SET_BITS)};
+    }
+  }
+
+  for (const auto& trace_name : trace_names) {
+    if (!champsim::branch_tracereader::is_branch_trace(trace_name)) {
+      throw std::invalid_argument{"The trace " + trace_name + " is not a branch trace. Extract one with bptrace_extract."};
+    }
+    if (max_instr_option->count() == 0) {
+      auto trace_length = static_cast<long long>(champsim::branch_tracereader{trace_name}.instructions());
+      schedule.max_instructions = (trace_name == trace_names.front()) ? trace_length : std::min(schedule.max_instructions, trace_length);
+    }
+  }
+
+  fmt::print("\n*** ChampSim Meta Predictor Sweep ***\nCandidates: {}\nTraces: {}\nWorker threads: {}\n\n", std::size(candidates), std::size(trace_names), jobs);
+
+  auto results = champsim::sweep::successive_halving(candidates, schedule, [&](const auto& round, long long length) { return evaluate(trace_names, round, length, jobs); });
+
+  fmt::print("\n");
+  for (const auto& line : champsim::sweep::format_table(space, results)) {
+    fmt::print("{}\n", line);
+  }
+
+  return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Extract the branches of a ChampSim trace into a branch trace.
+ *
+ * The trace is read with the same tracereader as the simulator, so branch types and targets are decoded exactly as the core would
+ * decode them. The result can be replayed by bpsim in place of the full trace.
+ */
+
+#include <filesystem>
+#include <string>
+#include <CLI/CLI.hpp>
+#include <fmt/core.h>
+
+#include "branch_trace.h"
+#include "tracereader.h"
+
+int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
+{
+  CLI::App app{"Extract the branches of a ChampSim trace"};
+
+  bool knob_cloudsuite{false};
+  std::size_t block_records = champsim::branch_trace_format::DEFAULT_BLOCK_RECORDS;
+  std::string trace_name;
+  std::string output_name;
+
+  app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Read the trace using the cloudsuite format");
+  app.add_option("--block-records", block_records, "The number of branches in each compressed block")->check(CLI::PositiveNumber);
+  app.add_option("trace", trace_name, "The path to the trace")->required()->check(CLI::ExistingFile);
+  app.add_option("output", output_name, "The path of the branch trace to write")->required();
+
+  CLI11_PARSE(app, argc, argv);
+
+  auto trace = get_tracereader(trace_name, 0, knob_cloudsuite, false);
+  champsim::branch_tracewriter writer{output_name, block_records};
+  while (!trace.eof()) {
+    writer(trace());
+  }
+  writer.close();
+
+  champsim::branch_tracereader result{output_name};
+  fmt::print("Extracted {} branches of {} instructions from {}\n", result.branches(), result.instructions(), trace_name);
+  fmt::print("Wrote {} bytes to {} ({} bytes before)\n", std::filesystem::file_size(output_name), output_name, std::filesystem::file_size(trace_name));
+
+  return 0;
+}